@@ -3,9 +3,16 @@
 
 #include <cassert>
 #include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
 
+#include "..\math\accumulator.hpp"
+#include "..\math\barycentric_evaluator.hpp"
+#include "..\math\constant_tables.hpp"
 #include "..\math\polynomial.hpp"
 #include "..\math\square_matrix.hpp"
+#include "..\math\vector_kernel.hpp"
 #include "..\unit\interactive_proof.hpp"
 #include "..\unit\proof.hpp"
 #include "..\unit\query.hpp"
@@ -27,19 +34,20 @@ public:
     static InteractiveProof<Int> MakeRoundCoefficientProof(Int* op0, Int* op1, const size_t length,
                                                       size_t subvectorSize);
     static std::vector<Query<Int>> MakeRoundCoefficientQuery(Int random, size_t subvectorSize);
+
+private:
+    static constexpr size_t EVALUATION_FORM_THRESHOLD = 1536; // Node count up to which G is built from point values
+
+    static bool IsEvaluationForm(const size_t nNodes);
+    static Polynomial<Int> InterpolateGPolynomial(const Int* values0, const Int* values1, const size_t nPoly,
+                                                  const size_t nNodes);
 };
 
 template <typename Int> Int InnerProductCircuit<Int>::Forward(Int* op0, Int* op1, const size_t length)
 {
     assert(length > 0);
 
-    Int result((uint64_t)0);
-    for (size_t i = 0; i < length; ++i)
-    {
-        result += (*op0++) * (*op1++);
-    }
-
-    return result;
+    return VectorKernel<Int>::Dot(op0, op1, length);
 }
 
 template <typename Int>
@@ -55,9 +63,9 @@ Proof<Int> InnerProductCircuit<Int>::MakeProof(Int* op0, Int* op1, const size_t
     Int* const randoms = new Int[nGGateInput];
     Int* const points = new Int[nGGateInput * nPointsByOnePoly];
     std::memset(points, 0, (nGGateInput * nPointsByOnePoly) * sizeof(Int));
+    Int::FillRandom(randoms, nGGateInput);
     for (size_t i = 0; i < nGGateInput; ++i)
     {
-        randoms[i] = Int::GenerateRandom();
         points[i * nPointsByOnePoly] = randoms[i];
     }
     for (size_t i = 0; i < length; ++i)
@@ -68,21 +76,28 @@ Proof<Int> InnerProductCircuit<Int>::MakeProof(Int* op0, Int* op1, const size_t
         points[gateNumber + (inputNumber + nGGateInputHalf) * nPointsByOnePoly] = op1[i];
     }
 
-    Polynomial<Int>* polys = new Polynomial<Int>[nGGateInput];
-    for (size_t i = 0; i < nGGateInput; ++i)
+    Polynomial<Int> gPoly;
+    if (IsEvaluationForm(nPointsByOnePoly))
     {
-        polys[i] = Polynomial<Int>::LagrangeInterpolation(points + i * nPointsByOnePoly, nPointsByOnePoly);
+        gPoly = InterpolateGPolynomial(points, points + nGGateInputHalf * nPointsByOnePoly, nGGateInputHalf,
+                                       nPointsByOnePoly);
     }
-
-    Polynomial<Int> gPoly;
-    for (size_t i = 0; i < nGGateInputHalf; ++i)
+    else
     {
-        gPoly += polys[i] * polys[i + nGGateInputHalf];
+        Polynomial<Int>* polys = new Polynomial<Int>[nGGateInput];
+        for (size_t i = 0; i < nGGateInput; ++i)
+        {
+            polys[i] = Polynomial<Int>::LagrangeInterpolation(points + i * nPointsByOnePoly, nPointsByOnePoly);
+        }
+        for (size_t i = 0; i < nGGateInputHalf; ++i)
+        {
+            gPoly.MultiplyAdd(polys[i], polys[i + nGGateInputHalf]);
+        }
+        delete[] polys;
     }
 
     Proof<Int> proof(op0, op1, length, randoms, nGGateInput, gPoly);
 
-    delete[] polys;
     delete[] points;
     delete[] randoms;
 
@@ -102,9 +117,9 @@ Proof<Int> InnerProductCircuit<Int>::MakeProofWithPrecompute(Int* op0, Int* op1,
     Int* const randoms = new Int[nGGateInput];
     Int* const points = new Int[nGGateInput * nPointsByOnePoly];
     std::memset(points, 0, (nGGateInput * nPointsByOnePoly) * sizeof(Int));
+    Int::FillRandom(randoms, nGGateInput);
     for (size_t i = 0; i < nGGateInput; ++i)
     {
-        randoms[i] = Int::GenerateRandom();
         points[i * nPointsByOnePoly] = randoms[i];
     }
     for (size_t i = 0; i < length; ++i)
@@ -125,7 +140,7 @@ Proof<Int> InnerProductCircuit<Int>::MakeProofWithPrecompute(Int* op0, Int* op1,
     Polynomial<Int> gPoly;
     for (size_t i = 0; i < nGGateInputHalf; ++i)
     {
-        gPoly += polys[i] * polys[i + nGGateInputHalf];
+        gPoly.MultiplyAdd(polys[i], polys[i + nGGateInputHalf]);
     }
 
     Proof<Int> proof(op0, op1, length, randoms, nGGateInput, gPoly);
@@ -148,18 +163,7 @@ std::vector<Query<Int>> InnerProductCircuit<Int>::MakeQuery(Int random, const si
 
     // Get coefficients of interpolation for the evaluation at r
     std::vector<Int> interpolationCoefficients(nGGate + 1);
-    for (size_t i = 0; i < nGGate + 1; i++)
-    {
-        Int term(1);
-        for (int j = 0; j < nGGate + 1; j++)
-        {
-            if (j != i)
-            {
-                term *= (random - Int(j)) * (Int(i) - Int(j)).Invert();
-            }
-        }
-        interpolationCoefficients[i] = term;
-    }
+    BarycentricEvaluator<Int>::CopyWeights(interpolationCoefficients.data(), random, nGGate + 1);
 
     const size_t queryLength = inputSize * 2 + nGGateInput + nCoefficients;
     const size_t nQuery = nGGateInput + 2;
@@ -201,30 +205,9 @@ std::vector<Query<Int>> InnerProductCircuit<Int>::MakeQuery(Int random, const si
         power *= random;
     }
 
-    Int* powers = new Int[nGGate];
-    for (size_t j = 0; j < nGGate; ++j)
-    {
-        powers[j] = Int(1u);
-    }
-
-    // Construct the queries to get the circuit output
+    // Construct the queries to get the circuit output : the i-th coefficient is summed over the nodes 1, ..., nGGate
     queriesCurr += inputSize * 2 + nGGateInput;
-    *queriesCurr = nGGate;
-    ++queriesCurr;
-    for (size_t i = 1; i < nCoefficients; ++i)
-    {
-        Int sum((uint64_t)0);
-        for (size_t j = 0; j < nGGate; ++j)
-        {
-            powers[j] *= Int(j + 1);
-            sum += powers[j];
-        }
-        *queriesCurr = sum;
-        ++queriesCurr;
-    }
-
-    delete[] powers;
-    powers = (Int*)0;
+    ConstantTables<Int>::CopyPowerSums(queriesCurr, nGGate);
 
     std::vector<Query<Int>> queryVectors(nQuery);
     for (size_t i = 0; i < nQuery; ++i)
@@ -249,16 +232,15 @@ Proof<Int> InnerProductCircuit<Int>::MakeCoefficientProof(Int* op0, Int* op1, co
 
     const size_t nRandoms = nPoly * 2;
     Int* randoms = new Int[nRandoms];
+    Int::FillRandom(randoms, nRandoms);
 
     Polynomial<Int> gPoly;
     for (size_t i = 0; i < nPoly; ++i)
     {
-        randoms[i] = Int::GenerateRandom();
         Polynomial<Int> poly0(randoms[i], op0 + i * polyLength, polyLength);
         Int::Reverse(op1 + i * polyLength, op1 + (i + 1) * polyLength - 1);
-        randoms[i + nPoly] = Int::GenerateRandom();
         Polynomial<Int> poly1(randoms[i + nPoly], op1 + i * polyLength, polyLength);
-        gPoly += poly0 * poly1;
+        gPoly.MultiplyAdd(poly0, poly1);
         Int::Reverse(op1 + i * polyLength, op1 + (i + 1) * polyLength - 1);
     }
 
@@ -345,6 +327,18 @@ InteractiveProof<Int> InnerProductCircuit<Int>::MakeRoundProof(Int* op0, Int* op
     std::memcpy(resizedInput, op0, length * sizeof(Int));
     std::memcpy(resizedInput + nPoly * subvectorSize, op1, length * sizeof(Int));
 
+    if (IsEvaluationForm(subvectorSize))
+    {
+        const Int* const values0 = resizedInput;
+        const Int* const values1 = resizedInput + nPoly * subvectorSize;
+        Polynomial<Int> gPoly = InterpolateGPolynomial(values0, values1, nPoly, subvectorSize);
+        std::vector<Int> valuesP(values0, values1);
+        std::vector<Int> valuesQ(values1, values1 + nPoly * subvectorSize);
+        delete[] resizedInput;
+
+        return InteractiveProof<Int>(std::move(valuesP), std::move(valuesQ), subvectorSize, gPoly);
+    }
+
     Polynomial<Int> gPoly;
     std::vector<Polynomial<Int>> poly0s;
     poly0s.reserve(nPoly);
@@ -355,9 +349,9 @@ InteractiveProof<Int> InnerProductCircuit<Int>::MakeRoundProof(Int* op0, Int* op
         Polynomial<Int> poly0 = Polynomial<Int>::LagrangeInterpolation(resizedInput + subvectorSize * i, subvectorSize);
         Polynomial<Int> poly1 =
             Polynomial<Int>::LagrangeInterpolation(resizedInput + subvectorSize * (nPoly + i), subvectorSize);
-        gPoly += poly0 * poly1;
-        poly0s.emplace_back(poly0);
-        poly1s.emplace_back(poly1);
+        gPoly.MultiplyAdd(poly0, poly1);
+        poly0s.emplace_back(std::move(poly0));
+        poly1s.emplace_back(std::move(poly1));
     }
 
     delete[] resizedInput;
@@ -391,9 +385,9 @@ InteractiveProof<Int> InnerProductCircuit<Int>::MakeRoundProofWithPrecompute(Int
             Polynomial<Int>::VandermondeInterpolation(resizedInput + subvectorSize * i, subvectorSize, evalToCoeff);
         Polynomial<Int> poly1 = Polynomial<Int>::VandermondeInterpolation(resizedInput + subvectorSize * (nPoly + i),
                                                                           subvectorSize, evalToCoeff);
-        gPoly += poly0 * poly1;
-        poly0s.emplace_back(poly0);
-        poly1s.emplace_back(poly1);
+        gPoly.MultiplyAdd(poly0, poly1);
+        poly0s.emplace_back(std::move(poly0));
+        poly1s.emplace_back(std::move(poly1));
     }
 
     delete[] resizedInput;
@@ -412,25 +406,10 @@ std::vector<Query<Int>> InnerProductCircuit<Int>::MakeRoundQuery(Int random, siz
     Int* const queries = new Int[queryLength * 2u];
     Int* queriesCurr = queries;
 
-    Int* const powers = new Int[subvectorSize];
-    for (size_t j = 0; j < subvectorSize; ++j)
-    {
-        powers[j] = Int(1u);
-    }
-
-    *queriesCurr = Int(subvectorSize);
-    ++queriesCurr;
-    for (size_t i = 1; i < queryLength; ++i)
-    {
-        Int sum((uint64_t)0);
-        for (size_t j = 0; j < subvectorSize - 1; ++j)
-        {
-            powers[j] *= Int(j + 1);
-            sum += powers[j];
-        }
-        *queriesCurr = sum;
-        ++queriesCurr;
-    }
+    // Sum of the coefficients over the nodes 0, ..., subvectorSize - 1, where the node 0 only adds 1 to the constant
+    ConstantTables<Int>::CopyPowerSums(queriesCurr, subvectorSize - 1u);
+    *queriesCurr += Int(1u);
+    queriesCurr += queryLength;
 
     Int power(1u);
     for (size_t i = 0; i < queryLength; ++i)
@@ -443,7 +422,6 @@ std::vector<Query<Int>> InnerProductCircuit<Int>::MakeRoundQuery(Int random, siz
     queryVectors.emplace_back(queries, queryLength);
     queryVectors.emplace_back(queries + queryLength, queryLength);
 
-    delete[] powers;
     delete[] queries;
 
     return queryVectors;
@@ -475,9 +453,9 @@ InteractiveProof<Int> InnerProductCircuit<Int>::MakeRoundCoefficientProof(Int* o
         Int::Reverse(resizedInput + subvectorSize * (nPoly + i),
                      resizedInput + subvectorSize * (nPoly + i) + subvectorSize - 1);
         Polynomial<Int> poly1(resizedInput + subvectorSize * (nPoly + i), subvectorSize, true);
-        gPoly += poly0 * poly1;
-        poly0s.emplace_back(poly0);
-        poly1s.emplace_back(poly1);
+        gPoly.MultiplyAdd(poly0, poly1);
+        poly0s.emplace_back(std::move(poly0));
+        poly1s.emplace_back(std::move(poly1));
     }
 
     delete[] resizedInput;
@@ -515,4 +493,63 @@ std::vector<Query<Int>> InnerProductCircuit<Int>::MakeRoundCoefficientQuery(Int
     return queryVectors;
 }
 
+// Fast multiplication (NTT fields and Mpint32 from CircleFft) makes the coefficient form cheaper for many nodes
+template <typename Int> bool InnerProductCircuit<Int>::IsEvaluationForm(const size_t nNodes)
+{
+    if constexpr (NttField<Int> || QuadraticNttField<Int>)
+    {
+        return nNodes <= EVALUATION_FORM_THRESHOLD;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+/*
+ * G = sum_i P_i Q_i for P_i and Q_i given by their values at the nodes 0, ..., n - 1 : both are extended to the nodes
+ * n, ..., 2n - 2 by Lagrange weights, G is summed pointwise at all 2n - 1 nodes, and only G is interpolated.
+ * Weights are computed one extended node at a time and applied to every pair, so memory stays O(n).
+ */
+template <typename Int>
+Polynomial<Int> InnerProductCircuit<Int>::InterpolateGPolynomial(const Int* values0, const Int* values1,
+                                                                 const size_t nPoly, const size_t nNodes)
+{
+    assert(nNodes > 1u);
+
+    const size_t nExtendedNodes = nNodes - 1u;
+    const size_t nEvaluations = nNodes + nExtendedNodes;
+
+    std::vector<Accumulator<Int>> sums(nEvaluations);
+    for (size_t i = 0; i < nPoly; ++i)
+    {
+        const Int* const p = values0 + i * nNodes;
+        const Int* const q = values1 + i * nNodes;
+        for (size_t k = 0; k < nNodes; ++k)
+        {
+            sums[k].MultiplyAdd(p[k], q[k]);
+        }
+    }
+
+    std::vector<Int> weights(nNodes); // Lagrange weights at the node n + m
+    for (size_t m = 0; m < nExtendedNodes; ++m)
+    {
+        BarycentricEvaluator<Int>::CopyWeights(weights.data(), Int(nNodes + m), nNodes);
+        for (size_t i = 0; i < nPoly; ++i)
+        {
+            const Int* const p = values0 + i * nNodes;
+            const Int* const q = values1 + i * nNodes;
+            sums[nNodes + m].MultiplyAdd(VectorKernel<Int>::Dot(weights.data(), p, nNodes),
+                                         VectorKernel<Int>::Dot(weights.data(), q, nNodes));
+        }
+    }
+
+    std::vector<Int> evaluations(nEvaluations);
+    for (size_t k = 0; k < nEvaluations; ++k)
+    {
+        evaluations[k] = sums[k].Get();
+    }
+    return Polynomial<Int>::LagrangeInterpolation(evaluations.data(), nEvaluations);
+}
+
 #endif
@@ -92,17 +92,12 @@ template <typename Int>
 OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t compressFactor)
 {
     Int::SetSeed(mSeed);
+    OperationCounter::BeginPhase("setup");
 
     std::vector<Int> op0(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0.data(), inputLength);
     std::vector<Int> op1(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1.data(), inputLength);
 
     std::vector<Int> op0Share(inputLength);
     std::vector<Int> op1Share(inputLength);
@@ -137,6 +132,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         SquareMatrix<Int> vanInv = SquareMatrix<Int>::GetVandermondeInverse(compressFactor);
 
         // Prover
+        OperationCounter::BeginPhase("prover");
         auto start = std::chrono::high_resolution_clock::now();
         InteractiveProof<Int> proof = InnerProductCircuit<Int>::MakeRoundProofWithPrecompute(
             op0.data(), op1.data(), op0.size(), compressFactor, vanInv);
@@ -148,9 +144,11 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         {
             randoms[i] = proofShares[i].GetRandomFromOracle(secretKey, 64);
         }
+        Int::Canonicalize(randoms, nVerifiers);
         SHA512_CTX ctx;
         unsigned char digest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&ctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&ctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(digest, &ctx);
         Int commonRandom = Int(digest);
@@ -161,13 +159,14 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
 
         // Communication : (proof, verifier-specific random, common random)
         // Assumption : the transmissions to multiple verifiers simultaneously occur.
-        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + 2 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + 2 * sizeof(Int));
-        totalPayloadSize += proof.GetBytes() + 2 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(2));
+        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(2));
+        totalPayloadSize += proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(2);
 
         Int* verificationShares = new Int[nVerifiers];
 
         // First verifier
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         std::vector<Query<Int>> queries = InnerProductCircuit<Int>::MakeRoundQuery(commonRandom, compressFactor);
         verificationShares[0] = proofShares[0].GetQueryAnswer(queries[0]) - outShares[0];
@@ -186,12 +185,13 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         
 
         // Communication - Verifiers send their own 'verificationShares' value, its own random.
-        LANTime += Network::GetLANPayloadDelay(2 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(2 * sizeof(Int));
-        totalPayloadSize += 2 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(PackedCodec<Int>::GetPackedBytes(2));
+        WANTime += Network::GetWANPayloadDelay(PackedCodec<Int>::GetPackedBytes(2));
+        totalPayloadSize += PackedCodec<Int>::GetPackedBytes(2);
 
 
         // Collector (one of the verifiers)
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         Int verificationValue((uint64_t)0);
         for (size_t i = 0; i < nVerifiers; ++i)
@@ -203,6 +203,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         SHA512_CTX vctx;
         unsigned char vdigest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&vctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&vctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(vdigest, &vctx);
         Int totalRandomOfVerifiers = Int(vdigest);
@@ -241,6 +242,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         verifierTime += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
         // Prover
+        OperationCounter::BeginPhase("prover");
         start = std::chrono::high_resolution_clock::now();
         op0 = proof.EvaluatePolyPs(commonRandom);
         op1 = proof.EvaluatePolyQs(commonRandom);
@@ -256,6 +258,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         SquareMatrix<Int> evalToCoeff = SquareMatrix<Int>::GetVandermondeInverse(op0.size() + 1);
 
         // Prover
+        OperationCounter::BeginPhase("prover");
         auto start = std::chrono::high_resolution_clock::now();
         Proof proof = InnerProductCircuit<Int>::MakeProofWithPrecompute(op0.data(), op1.data(), op0.size(), op0.size(),
                                                                         evalToCoeff);
@@ -266,9 +269,11 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         {
             randoms[i] = proofShares[i].GetRandomFromOracle(secretKey, 64);
         }
+        Int::Canonicalize(randoms, nVerifiers);
         SHA512_CTX ctx;
         unsigned char digest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&ctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&ctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(digest, &ctx);
         Int commonRandom = Int(digest);
@@ -278,9 +283,9 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
 
 
         // Communication
-        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + 4 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + 4 * sizeof(Int));
-        totalPayloadSize += proof.GetBytes() + 4 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(4));
+        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(4));
+        totalPayloadSize += proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(4);
 
         std::vector<Int> randomsInConstantTerms = proof.GetRandoms(2);
         Int* verificationShares = new Int[nVerifiers];
@@ -289,6 +294,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
 
 
         // First verifier
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         std::vector<Query<Int>> queries = InnerProductCircuit<Int>::MakeQuery(commonRandom, op0.size(), op0.size());
         isValid = isValid && (randoms[0] == proofShares[0].GetRandomFromOracle(secretKey, 64));
@@ -346,12 +352,13 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
 
         // Communication - Verifiers share two evaluationShares, one varificationShare,
         // one resultShare, private random.
-        LANTime += Network::GetLANPayloadDelay(5 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(5 * sizeof(Int));
-        totalPayloadSize += 5 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(PackedCodec<Int>::GetPackedBytes(5));
+        WANTime += Network::GetWANPayloadDelay(PackedCodec<Int>::GetPackedBytes(5));
+        totalPayloadSize += PackedCodec<Int>::GetPackedBytes(5);
 
 
         // Collector
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         Int verificationValue((uint64_t)0);
         Int ps((uint64_t)0);
@@ -380,6 +387,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPOneRound(size_t inputLength, size_t c
         SHA512_CTX vctx;
         unsigned char vdigest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&vctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&vctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(vdigest, &vctx);
         Int totalRandomOfVerifiers = Int(vdigest);
@@ -410,17 +418,12 @@ template <typename Int>
 OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLength, size_t compressFactor)
 {
     Int::SetSeed(mSeed);
+    OperationCounter::BeginPhase("setup");
 
     std::vector<Int> op0(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0.data(), inputLength);
     std::vector<Int> op1(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1.data(), inputLength);
 
     std::vector<Int> op0Share(inputLength);
     std::vector<Int> op1Share(inputLength);
@@ -449,6 +452,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
     if (ceil(op0.size() / (double)compressFactor) > 1)
     {
         // Prover
+        OperationCounter::BeginPhase("prover");
         auto start = std::chrono::high_resolution_clock::now();
         InteractiveProof<Int> proof =
             InnerProductCircuit<Int>::MakeRoundCoefficientProof(op0.data(), op1.data(), op0.size(), compressFactor);
@@ -459,9 +463,11 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
         {
             randoms[i] = proofShares[i].GetRandomFromOracle(secretKey, 64);
         }
+        Int::Canonicalize(randoms, nVerifiers);
         SHA512_CTX ctx;
         unsigned char digest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&ctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&ctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(digest, &ctx);
         Int commonRandom = Int(digest);
@@ -470,13 +476,14 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
         proverTime += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
         // Communication
-        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + 2 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + 2 * sizeof(Int));
-        totalPayloadSize += proof.GetBytes() + 2 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(2));
+        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(2));
+        totalPayloadSize += proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(2);
 
         Int* verificationShares = new Int[nVerifiers];
 
         // First verifier
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         std::vector<Query<Int>> queries =
             InnerProductCircuit<Int>::MakeRoundCoefficientQuery(commonRandom, compressFactor);
@@ -496,12 +503,13 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
 
 
         // Communication - Verifiers send their own 'verificationShares' value, its own random.
-        LANTime += Network::GetLANPayloadDelay(2 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(2 * sizeof(Int));
-        totalPayloadSize += 2 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(PackedCodec<Int>::GetPackedBytes(2));
+        WANTime += Network::GetWANPayloadDelay(PackedCodec<Int>::GetPackedBytes(2));
+        totalPayloadSize += PackedCodec<Int>::GetPackedBytes(2);
 
 
         // Collector (one of the verifiers)
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         Int verificationValue((uint64_t)0);
         for (size_t i = 0; i < nVerifiers; ++i)
@@ -513,6 +521,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
         SHA512_CTX vctx;
         unsigned char vdigest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&vctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&vctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(vdigest, &vctx);
         Int totalRandomOfVerifiers = Int(vdigest);
@@ -550,6 +559,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
         verifierTime += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
         // Prover
+        OperationCounter::BeginPhase("prover");
         start = std::chrono::high_resolution_clock::now();
         op0 = proof.EvaluatePolyPs(commonRandom);
         op1 = proof.EvaluatePolyQs(commonRandom);
@@ -562,6 +572,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
     else
     {
         // Prover
+        OperationCounter::BeginPhase("prover");
         auto start = std::chrono::high_resolution_clock::now();
         Proof<Int> proof = InnerProductCircuit<Int>::MakeCoefficientProof(op0.data(), op1.data(), op0.size(), 1);
         std::vector<Proof<Int>> proofShares = proof.GetShares(nVerifiers);
@@ -571,9 +582,11 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
         {
             randoms[i] = proofShares[i].GetRandomFromOracle(secretKey, 64);
         }
+        Int::Canonicalize(randoms, nVerifiers);
         SHA512_CTX ctx;
         unsigned char digest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&ctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&ctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(digest, &ctx);
         Int commonRandom = Int(digest);
@@ -583,9 +596,9 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
 
 
         // Communication
-        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + 4 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + 4 * sizeof(Int));
-        totalPayloadSize += proof.GetBytes() + 4 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(4));
+        WANTime += Network::GetWANPayloadDelay(proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(4));
+        totalPayloadSize += proof.GetBytes() + PackedCodec<Int>::GetPackedBytes(4);
 
         std::vector<Int> randomsInConstantTerms = proof.GetRandoms(2);
         Int* verificationShares = new Int[nVerifiers];
@@ -594,6 +607,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
 
 
         // First verifier
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         std::vector<Query<Int>> queries = InnerProductCircuit<Int>::MakeCoefficientQuery(commonRandom, op0.size(), 1);
         isValid = isValid && (randoms[0] == proofShares[0].GetRandomFromOracle(secretKey, 64));
@@ -648,11 +662,12 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
 
         // Communication - Verifiers share two evaluationShares, one varificationShare,
         // one resultShare, private random.
-        LANTime += Network::GetLANPayloadDelay(5 * sizeof(Int));
-        WANTime += Network::GetWANPayloadDelay(5 * sizeof(Int));
-        totalPayloadSize += 5 * sizeof(Int);
+        LANTime += Network::GetLANPayloadDelay(PackedCodec<Int>::GetPackedBytes(5));
+        WANTime += Network::GetWANPayloadDelay(PackedCodec<Int>::GetPackedBytes(5));
+        totalPayloadSize += PackedCodec<Int>::GetPackedBytes(5);
 
         // Collector
+        OperationCounter::BeginPhase("verifier");
         start = std::chrono::high_resolution_clock::now();
         Int verificationValue((uint64_t)0);
         Int ps((uint64_t)0);
@@ -681,6 +696,7 @@ OneRoundMeasurement MPC<Int>::SimulateFLIOPCoefficientOneRound(size_t inputLengt
         SHA512_CTX vctx;
         unsigned char vdigest[SHA512_DIGEST_LENGTH];
         SHA512_Init(&vctx);
+        OperationCounter::Count(OperationCounter::Operation::HashedByte, nVerifiers * sizeof(Int));
         SHA512_Update(&vctx, randoms, nVerifiers * sizeof(Int));
         SHA512_Final(vdigest, &vctx);
         Int totalRandomOfVerifiers = Int(vdigest);
@@ -3,9 +3,14 @@
 #include <iostream>
 #include <limits>
 #include <random>
+#include <type_traits>
 
 #include "performance_measurement.hpp"
+#include "..\math\gf2_64.hpp"
 #include "..\math\mpint32.hpp"
+#include "..\math\mpint64.hpp"
+#include "..\math\mpint128.hpp"
+#include "..\math\polynomial_multiplier.hpp"
 
 uint32_t PerformanceMeasurement::ReduceInt32To31(uint32_t x)
 {
@@ -451,6 +456,8 @@ void PerformanceMeasurement::CompareInt31Inversion()
 
     std::unique_ptr<uint32_t[]> expRes = std::make_unique<uint32_t[]>(nIteration);
     std::unique_ptr<uint32_t[]> euclideanRes = std::make_unique<uint32_t[]>(nIteration);
+    std::unique_ptr<uint32_t[]> chainRes = std::make_unique<uint32_t[]>(nIteration);
+    std::unique_ptr<uint32_t[]> divstepRes = std::make_unique<uint32_t[]>(nIteration);
 
     auto start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < nIteration; ++i)
@@ -474,17 +481,54 @@ void PerformanceMeasurement::CompareInt31Inversion()
     end = std::chrono::high_resolution_clock::now();
     double time_taken_euclidean = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nIteration; ++i)
+    {
+        for (size_t j = 0; j < nIteration; ++j)
+        {
+            chainRes[j] = Mpint32(targets[j]).InvertByAdditionChain().GetValue();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double time_taken_chain = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nIteration; ++i)
+    {
+        for (size_t j = 0; j < nIteration; ++j)
+        {
+            divstepRes[j] = Mpint32(targets[j]).InvertByDivstep().GetValue();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double time_taken_divstep = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
     for (size_t i = 0; i < nIteration; ++i)
     {
-        if (expRes[i] != euclideanRes[i])
+        if (expRes[i] != euclideanRes[i] || expRes[i] != chainRes[i] || expRes[i] != divstepRes[i])
         {
-            std::cout << "Two algorithm give different result!!!!" << std::endl;
+            std::cout << "Inversion algorithms give different results!!!!" << std::endl;
             return;
         }
     }
 
     std::cout << "Binary Exponentiation : " << time_taken_exp * 1e-6 << "ms" << std::endl;
     std::cout << "Extended Euclidean Algorithm : " << time_taken_euclidean * 1e-6 << "ms" << std::endl;
+    std::cout << "Addition Chain : " << time_taken_chain * 1e-6 << "ms" << std::endl;
+    std::cout << "Constant-time Divstep : " << time_taken_divstep * 1e-6 << "ms" << std::endl;
+    std::cout << "Mpint32::Invert uses : ";
+    switch (Mpint32::INVERSION_METHOD)
+    {
+    case Mpint32::InversionMethod::AdditionChain:
+        std::cout << "Addition Chain" << std::endl;
+        break;
+    case Mpint32::InversionMethod::Divstep:
+        std::cout << "Constant-time Divstep" << std::endl;
+        break;
+    default:
+        std::cout << "Binary Exponentiation" << std::endl;
+        break;
+    }
     std::cout << std::endl;
 }
 
@@ -505,6 +549,8 @@ void PerformanceMeasurement::CompareInt61Inversion()
 
     std::unique_ptr<uint64_t[]> expRes = std::make_unique<uint64_t[]>(nIteration);
     std::unique_ptr<uint64_t[]> euclideanRes = std::make_unique<uint64_t[]>(nIteration);
+    std::unique_ptr<uint64_t[]> chainRes = std::make_unique<uint64_t[]>(nIteration);
+    std::unique_ptr<uint64_t[]> divstepRes = std::make_unique<uint64_t[]>(nIteration);
 
     auto start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < nIteration; ++i)
@@ -528,16 +574,252 @@ void PerformanceMeasurement::CompareInt61Inversion()
     end = std::chrono::high_resolution_clock::now();
     double time_taken_euclidean = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nIteration; ++i)
+    {
+        for (size_t j = 0; j < nIteration; ++j)
+        {
+            chainRes[j] = Mpint64(targets[j]).InvertByAdditionChain().GetValue();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double time_taken_chain = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nIteration; ++i)
+    {
+        for (size_t j = 0; j < nIteration; ++j)
+        {
+            divstepRes[j] = Mpint64(targets[j]).InvertByDivstep().GetValue();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double time_taken_divstep = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
     for (size_t i = 0; i < nIteration; ++i)
     {
-        if (expRes[i] != euclideanRes[i])
+        if (expRes[i] != euclideanRes[i] || expRes[i] != chainRes[i] || expRes[i] != divstepRes[i])
         {
-            std::cout << "Two algorithm give different result!!!!" << std::endl;
+            std::cout << "Inversion algorithms give different results!!!!" << std::endl;
             return;
         }
     }
 
     std::cout << "Binary Exponentiation : " << time_taken_exp * 1e-6 << "ms" << std::endl;
     std::cout << "Extended Euclidean Algorithm : " << time_taken_euclidean * 1e-6 << "ms" << std::endl;
+    std::cout << "Addition Chain : " << time_taken_chain * 1e-6 << "ms" << std::endl;
+    std::cout << "Constant-time Divstep : " << time_taken_divstep * 1e-6 << "ms" << std::endl;
+    std::cout << "Mpint64::Invert uses : ";
+    switch (Mpint64::INVERSION_METHOD)
+    {
+    case Mpint64::InversionMethod::AdditionChain:
+        std::cout << "Addition Chain" << std::endl;
+        break;
+    case Mpint64::InversionMethod::Divstep:
+        std::cout << "Constant-time Divstep" << std::endl;
+        break;
+    default:
+        std::cout << "Binary Exponentiation" << std::endl;
+        break;
+    }
+    std::cout << std::endl;
+}
+
+void PerformanceMeasurement::CompareReductionPolicies()
+{
+    std::cout << "Comparison for Reduction Policies over Mersenne Prime Fields" << std::endl;
+
+    const size_t length = 4096;
+    const size_t nRound = 2000;
+
+    std::mt19937 randomGenerator = std::mt19937(10);
+    std::uniform_int_distribution<uint64_t> dist = std::uniform_int_distribution<uint64_t>(0u, BASE31 - 1);
+
+    std::unique_ptr<uint64_t[]> targets = std::make_unique<uint64_t[]>(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        targets[i] = (dist(randomGenerator) << 30) ^ dist(randomGenerator);
+    }
+
+    uint64_t eagerRes61, branchFreeRes61, lazyRes61;
+    double time_taken_eager61 =
+        MeasureArithmeticChain<BasicMpint64<EagerReduction>>(targets.get(), length, nRound, &eagerRes61);
+    double time_taken_branch_free61 =
+        MeasureArithmeticChain<BasicMpint64<BranchFreeReduction>>(targets.get(), length, nRound, &branchFreeRes61);
+    double time_taken_lazy61 =
+        MeasureArithmeticChain<BasicMpint64<LazyReduction>>(targets.get(), length, nRound, &lazyRes61);
+
+    uint64_t eagerRes31, branchFreeRes31, lazyRes31;
+    double time_taken_eager31 =
+        MeasureArithmeticChain<BasicMpint32<EagerReduction>>(targets.get(), length, nRound, &eagerRes31);
+    double time_taken_branch_free31 =
+        MeasureArithmeticChain<BasicMpint32<BranchFreeReduction>>(targets.get(), length, nRound, &branchFreeRes31);
+    double time_taken_lazy31 =
+        MeasureArithmeticChain<BasicMpint32<LazyReduction>>(targets.get(), length, nRound, &lazyRes31);
+
+    if (eagerRes61 != branchFreeRes61 || eagerRes61 != lazyRes61 || eagerRes31 != branchFreeRes31 ||
+        eagerRes31 != lazyRes31)
+    {
+        std::cout << "Reduction policies give different results!!!!" << std::endl;
+        return;
+    }
+
+    std::cout << "[61-bit] Eager : " << time_taken_eager61 * 1e-6 << "ms" << std::endl;
+    std::cout << "[61-bit] Branch-free : " << time_taken_branch_free61 * 1e-6 << "ms" << std::endl;
+    std::cout << "[61-bit] Lazy : " << time_taken_lazy61 * 1e-6 << "ms" << std::endl;
+    std::cout << "[31-bit] Eager : " << time_taken_eager31 * 1e-6 << "ms" << std::endl;
+    std::cout << "[31-bit] Branch-free : " << time_taken_branch_free31 * 1e-6 << "ms" << std::endl;
+    std::cout << "[31-bit] Lazy : " << time_taken_lazy31 * 1e-6 << "ms" << std::endl;
+    std::cout << "Mpint64 uses : "
+              << (std::is_same_v<Mpint64, BasicMpint64<LazyReduction>>         ? "Lazy"
+                  : std::is_same_v<Mpint64, BasicMpint64<BranchFreeReduction>> ? "Branch-free"
+                                                                               : "Eager")
+              << std::endl;
+    std::cout << "Mpint32 uses : "
+              << (std::is_same_v<Mpint32, BasicMpint32<LazyReduction>>         ? "Lazy"
+                  : std::is_same_v<Mpint32, BasicMpint32<BranchFreeReduction>> ? "Branch-free"
+                                                                               : "Eager")
+              << std::endl;
     std::cout << std::endl;
 }
+
+// One challenge over Z_{2^127 - 1} against repeating over Z_{2^61 - 1} or GF(2^64), on the same chain as the
+// reduction policies
+void PerformanceMeasurement::CompareSoundnessFields()
+{
+    std::cout << "Comparison for 127-bit Field and Repeated 61-bit and Binary 64-bit Fields" << std::endl;
+
+    const size_t length = 4096;
+    const size_t nRound = 2000;
+
+    std::mt19937 randomGenerator = std::mt19937(10);
+    std::uniform_int_distribution<uint64_t> dist = std::uniform_int_distribution<uint64_t>(0u, BASE31 - 1);
+
+    std::unique_ptr<uint64_t[]> targets = std::make_unique<uint64_t[]>(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        targets[i] = (dist(randomGenerator) << 30) ^ dist(randomGenerator);
+    }
+
+    uint64_t res61, res64, res127;
+    double time_taken61 = MeasureArithmeticChain<Mpint64>(targets.get(), length, nRound, &res61);
+    double time_taken64 = MeasureArithmeticChain<GF2_64>(targets.get(), length, nRound, &res64);
+    double time_taken127 = MeasureArithmeticChain<Mpint128>(targets.get(), length, nRound, &res127);
+
+    std::cout << "[61-bit] 1 repetition (61-bit soundness) : " << time_taken61 * 1e-6 << "ms" << std::endl;
+    std::cout << "[61-bit] 2 repetitions (122-bit soundness) : " << 2 * time_taken61 * 1e-6 << "ms" << std::endl;
+    std::cout << "[61-bit] 3 repetitions (183-bit soundness) : " << 3 * time_taken61 * 1e-6 << "ms" << std::endl;
+    std::cout << "[GF(2^64)] 1 repetition (64-bit soundness) : " << time_taken64 * 1e-6 << "ms" << std::endl;
+    std::cout << "[GF(2^64)] 2 repetitions (128-bit soundness) : " << 2 * time_taken64 * 1e-6 << "ms" << std::endl;
+    std::cout << "[127-bit] 1 run (127-bit soundness) : " << time_taken127 * 1e-6 << "ms" << std::endl;
+    std::cout << "127-bit run costs " << time_taken127 / time_taken61 << " 61-bit repetitions and "
+              << time_taken127 / time_taken64 << " GF(2^64) repetitions" << std::endl;
+    std::cout << std::endl;
+}
+
+void PerformanceMeasurement::ComparePolynomialMultiplication()
+{
+    std::cout << "Comparison for Polynomial Multiplication over Mersenne Prime Fields" << std::endl;
+
+    for (size_t length : {16, 32, 64, 128, 192, 256, 512, 1024})
+    {
+        const size_t nRound = ((size_t)1 << 24) / (length * length);
+        std::cout << "[61-bit] length " << length << " : ";
+        if (!MeasurePolynomialMultiplication<Mpint64>(length, nRound))
+        {
+            return;
+        }
+        std::cout << "[31-bit] length " << length << " : ";
+        if (!MeasurePolynomialMultiplication<Mpint32>(length, nRound))
+        {
+            return;
+        }
+    }
+    std::cout << "Karatsuba from length " << PolynomialMultiplier<Mpint64>::KARATSUBA_THRESHOLD << ", Toom-3 from length "
+              << PolynomialMultiplier<Mpint64>::TOOM3_THRESHOLD << std::endl;
+    std::cout << std::endl;
+}
+
+// Each method at the top level only, recursing through the current thresholds below it
+template <typename Int> bool PerformanceMeasurement::MeasurePolynomialMultiplication(const size_t length,
+                                                                                     const size_t nRound)
+{
+    const size_t productLength = 2 * length - 1;
+    std::unique_ptr<Int[]> op0 = std::make_unique<Int[]>(length);
+    std::unique_ptr<Int[]> op1 = std::make_unique<Int[]>(length);
+    std::unique_ptr<Int[]> schoolbookRes = std::make_unique<Int[]>(productLength);
+    std::unique_ptr<Int[]> karatsubaRes = std::make_unique<Int[]>(productLength);
+    std::unique_ptr<Int[]> toomRes = std::make_unique<Int[]>(productLength);
+    std::unique_ptr<Int[]> scratch = std::make_unique<Int[]>(8 * length);
+    Int::SetSeed(10);
+    Int::FillRandom(op0.get(), length);
+    Int::FillRandom(op1.get(), length);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nRound; ++i)
+    {
+        PolynomialMultiplier<Int>::MultiplySchoolbook(schoolbookRes.get(), op0.get(), length, op1.get(), length);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double time_taken_schoolbook = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nRound; ++i)
+    {
+        PolynomialMultiplier<Int>::MultiplyKaratsuba(karatsubaRes.get(), op0.get(), op1.get(), length, scratch.get());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double time_taken_karatsuba = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nRound; ++i)
+    {
+        PolynomialMultiplier<Int>::MultiplyToom3(toomRes.get(), op0.get(), op1.get(), length, scratch.get());
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double time_taken_toom = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    for (size_t i = 0; i < productLength; ++i)
+    {
+        if (schoolbookRes[i] != karatsubaRes[i] || schoolbookRes[i] != toomRes[i])
+        {
+            std::cout << "Multiplication algorithms give different results!!!!" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Schoolbook " << time_taken_schoolbook / nRound * 1e-3 << "us, Karatsuba "
+              << time_taken_karatsuba / nRound * 1e-3 << "us, Toom-3 " << time_taken_toom / nRound * 1e-3 << "us"
+              << std::endl;
+    return true;
+}
+
+// Horner-like chain of dependent multiplications, additions and subtractions, as in polynomial evaluation
+template <typename Int>
+double PerformanceMeasurement::MeasureArithmeticChain(const uint64_t* targets, const size_t length, const size_t nRound,
+                                                      uint64_t* result)
+{
+    Int* const values = new Int[length];
+    for (size_t i = 0; i < length; ++i)
+    {
+        values[i] = Int(targets[i]);
+    }
+
+    Int product((uint64_t)1);
+    Int sum((uint64_t)0);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < nRound; ++i)
+    {
+        for (size_t j = 0; j < length; ++j)
+        {
+            product = product * values[j] + values[length - 1 - j];
+            sum -= product;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    *result = (uint64_t)(product + sum).GetValue();
+    delete[] values;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
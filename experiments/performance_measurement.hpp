@@ -34,6 +34,14 @@ public:
     static void CompareInt64To61Reduction();
     static void CompareInt31Inversion();
     static void CompareInt61Inversion();
+    static void CompareReductionPolicies();
+    static void CompareSoundnessFields();
+    static void ComparePolynomialMultiplication();
+
+    template <typename Int>
+    static double MeasureArithmeticChain(const uint64_t* targets, const size_t length, const size_t nRound,
+                                         uint64_t* result);
+    template <typename Int> static bool MeasurePolynomialMultiplication(const size_t length, const size_t nRound);
 };
 
 #endif
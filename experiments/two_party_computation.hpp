@@ -1,11 +1,14 @@
 #ifndef TWO_PARTY_COMPUTATION_H
 #define TWO_PARTY_COMPUTATION_H
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
 #include "network.hpp"
 #include "../circuit/inner_product_circuit.hpp"
+#include "../math/barycentric_evaluator.hpp"
+#include "../math/lanes.hpp"
 #include "../math/square_matrix.hpp"
 #include "../unit/proof.hpp"
 
@@ -16,35 +19,44 @@ public:
     static FLPCPMeasurement FLPCP(const uint32_t seed, const size_t inputLength, const size_t nGGate);
     static FLPCPMeasurement FLPCPWithPrecompute(const uint32_t seed, const size_t inputLength, const size_t nGGate);
     static FLPCPMeasurement FLPCPCoefficient(const uint32_t seed, const size_t inputLength, const size_t nGGate);
+    template <size_t K>
+    static FLPCPMeasurement FLPCPExtensionChallenge(const uint32_t seed, const size_t inputLength, const size_t nGGate);
     static void ExperimentFLPCP(size_t nCases, size_t nExperiments);
+    static void ExperimentFLPCPExtensionChallenge(size_t nCases, size_t nExperiments);
 
     // Fully Linear IOP
     static FLIOPMeasurement FLIOP(const size_t seed, const size_t inputLength, const size_t compressFactor);
+    static FLIOPMeasurement FLIOP(std::vector<Int> op0, std::vector<Int> op1, const size_t compressFactor);
+    template <size_t K>
+    static FLIOPMeasurement FLIOPParallelRepetition(const size_t seed, const size_t inputLength,
+                                                    const size_t compressFactor);
     static FLIOPMeasurement FLIOPWithPrecompute(const size_t seed, const size_t inputLength,
                                                 const size_t compressFactor);
     static FLIOPMeasurement FLIOPCoefficient(const size_t seed, const size_t inputLength, const size_t compressFactor);
     static void ExperimentFLIOP(size_t nCases, size_t nExperiments);
+    template <size_t K>
+    static void ExperimentParallelRepetition(const size_t inputLength, const size_t compressFactor,
+                                             size_t nExperiments);
+
+    // Operation counts per phase of every variant, for Int = CountingInt<...> (counting_int.hpp)
+    static void ExperimentOperationCounts(const size_t inputLength, const size_t nGGate, const size_t compressFactor);
 };
 
 template <typename Int>
 FLPCPMeasurement TwoPC<Int>::FLPCP(const uint32_t seed, const size_t inputLength, const size_t nGGate)
 {
     Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
 
     Int* const op0 = new Int[inputLength];
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0, inputLength);
     Int* const op1 = new Int[inputLength];
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1, inputLength);
 
     const Int circuitOutput = InnerProductCircuit<Int>::Forward(op0, op1, inputLength);
 
     // Prover make proof vector : (inputs || constant terms || coefficients)
+    OperationCounter::BeginPhase("prover");
     auto start = std::chrono::high_resolution_clock::now();
     Proof<Int> proof = InnerProductCircuit<Int>::MakeProof(op0, op1, inputLength, nGGate);
     auto end = std::chrono::high_resolution_clock::now();
@@ -52,18 +64,19 @@ FLPCPMeasurement TwoPC<Int>::FLPCP(const uint32_t seed, const size_t inputLength
 
     // Verifier make queries and perform inner products between proof and queries.
     // Assumption : Verifier only has linear access on proof vector.
+    OperationCounter::BeginPhase("verifier");
     start = std::chrono::high_resolution_clock::now();
     std::vector<Query<Int>> queries =
         InnerProductCircuit<Int>::MakeQuery(Int::GenerateRandomAbove(nGGate + 1), nGGate, inputLength);
 
     const size_t nInputQueriesHalf = (queries.size() - 2u) / 2u;
-    Int gR((uint32_t)0);
+    Accumulator<Int> gR;
     for (size_t i = 0; i < nInputQueriesHalf; ++i)
     {
-        gR += proof.GetQueryAnswer(queries[i]) * proof.GetQueryAnswer(queries[i + nInputQueriesHalf]);
+        gR.MultiplyAdd(proof.GetQueryAnswer(queries[i]), proof.GetQueryAnswer(queries[i + nInputQueriesHalf]));
     }
 
-    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR) &&
+    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR.Get()) &&
                    (proof.GetQueryAnswer(queries[queries.size() - 1u]) == circuitOutput);
 
     end = std::chrono::high_resolution_clock::now();
@@ -79,17 +92,12 @@ template <typename Int>
 FLPCPMeasurement TwoPC<Int>::FLPCPWithPrecompute(const uint32_t seed, const size_t inputLength, const size_t nGGate)
 {
     Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
 
     Int* const op0 = new Int[inputLength];
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0, inputLength);
     Int* const op1 = new Int[inputLength];
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1, inputLength);
 
     const Int circuitOutput = InnerProductCircuit<Int>::Forward(op0, op1, inputLength);
     SquareMatrix<Int> vandermondeInv = SquareMatrix<Int>::GetVandermondeInverse(nGGate + 1);
@@ -100,6 +108,7 @@ FLPCPMeasurement TwoPC<Int>::FLPCPWithPrecompute(const uint32_t seed, const size
     const size_t nInputQueriesHalf = (queries.size() - 2u) / 2u;
 
     // Prover make proof vector : (inputs || constant terms || coefficients)
+    OperationCounter::BeginPhase("prover");
     auto start = std::chrono::high_resolution_clock::now();
     Proof<Int> proof = InnerProductCircuit<Int>::MakeProofWithPrecompute(op0, op1, inputLength, nGGate, vandermondeInv);
     auto end = std::chrono::high_resolution_clock::now();
@@ -107,14 +116,15 @@ FLPCPMeasurement TwoPC<Int>::FLPCPWithPrecompute(const uint32_t seed, const size
 
     // Verifier make queries and perform inner products between proof and queries.
     // Assumption : Verifier only has linear access on proof vector.
+    OperationCounter::BeginPhase("verifier");
     start = std::chrono::high_resolution_clock::now();
-    Int gR((uint32_t)0);
+    Accumulator<Int> gR;
     for (size_t i = 0; i < nInputQueriesHalf; ++i)
     {
-        gR += proof.GetQueryAnswer(queries[i]) * proof.GetQueryAnswer(queries[i + nInputQueriesHalf]);
+        gR.MultiplyAdd(proof.GetQueryAnswer(queries[i]), proof.GetQueryAnswer(queries[i + nInputQueriesHalf]));
     }
 
-    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR) &&
+    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR.Get()) &&
                    (proof.GetQueryAnswer(queries[queries.size() - 1u]) == circuitOutput);
 
     end = std::chrono::high_resolution_clock::now();
@@ -131,36 +141,33 @@ template <typename Int>
 FLPCPMeasurement TwoPC<Int>::FLPCPCoefficient(const uint32_t seed, const size_t inputLength, const size_t nPoly)
 {
     Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
 
     Int* const op0 = new Int[inputLength];
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0, inputLength);
     Int* const op1 = new Int[inputLength];
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1, inputLength);
 
     const Int circuitOutput = InnerProductCircuit<Int>::Forward(op0, op1, inputLength);
 
+    OperationCounter::BeginPhase("prover");
     auto start = std::chrono::high_resolution_clock::now();
     Proof<Int> proof = InnerProductCircuit<Int>::MakeCoefficientProof(op0, op1, inputLength, nPoly);
     auto end = std::chrono::high_resolution_clock::now();
     double proverTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
+    OperationCounter::BeginPhase("verifier");
     start = std::chrono::high_resolution_clock::now();
     std::vector<Query<Int>> queries =
         InnerProductCircuit<Int>::MakeCoefficientQuery(Int::GenerateRandom(), inputLength, nPoly);
     const size_t nInputQueriesHalf = (queries.size() - 2u) / 2u;
 
-    Int gR((uint32_t)0);
+    Accumulator<Int> gR;
     for (size_t i = 0; i < nInputQueriesHalf; ++i)
     {
-        gR += proof.GetQueryAnswer(queries[i]) * proof.GetQueryAnswer(queries[i + nInputQueriesHalf]);
+        gR.MultiplyAdd(proof.GetQueryAnswer(queries[i]), proof.GetQueryAnswer(queries[i + nInputQueriesHalf]));
     }
-    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR) &&
+    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR.Get()) &&
                    (proof.GetQueryAnswer(queries[queries.size() - 1u]) == circuitOutput);
     end = std::chrono::high_resolution_clock::now();
     double verifierTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
@@ -171,6 +178,53 @@ FLPCPMeasurement TwoPC<Int>::FLPCPCoefficient(const uint32_t seed, const size_t
     return FLPCPMeasurement(proof.GetBytes(), queries.size(), proverTime * 1e-6, verifierTime * 1e-6, isValid);
 }
 
+// Fully Linear PCP over Int whose challenge and queries live in Ext<Int, K> for soundness error about nGGate / p^K
+template <typename Int>
+template <size_t K>
+FLPCPMeasurement TwoPC<Int>::FLPCPExtensionChallenge(const uint32_t seed, const size_t inputLength,
+                                                     const size_t nGGate)
+{
+    Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
+
+    Int* const op0 = new Int[inputLength];
+    Int::FillRandom(op0, inputLength);
+    Int* const op1 = new Int[inputLength];
+    Int::FillRandom(op1, inputLength);
+
+    const Int circuitOutput = InnerProductCircuit<Int>::Forward(op0, op1, inputLength);
+
+    // Prover works in the base field only
+    OperationCounter::BeginPhase("prover");
+    auto start = std::chrono::high_resolution_clock::now();
+    Proof<Int> proof = InnerProductCircuit<Int>::MakeProof(op0, op1, inputLength, nGGate);
+    auto end = std::chrono::high_resolution_clock::now();
+    double proverTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    OperationCounter::BeginPhase("verifier");
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<Query<Ext<Int, K>>> queries = InnerProductCircuit<Ext<Int, K>>::MakeQuery(
+        Ext<Int, K>::GenerateRandomAbove(nGGate + 1), nGGate, inputLength);
+
+    const size_t nInputQueriesHalf = (queries.size() - 2u) / 2u;
+    Accumulator<Ext<Int, K>> gR;
+    for (size_t i = 0; i < nInputQueriesHalf; ++i)
+    {
+        gR.MultiplyAdd(proof.GetQueryAnswer(queries[i]), proof.GetQueryAnswer(queries[i + nInputQueriesHalf]));
+    }
+
+    bool isValid = (proof.GetQueryAnswer(queries[queries.size() - 2u]) == gR.Get()) &&
+                   (proof.GetQueryAnswer(queries[queries.size() - 1u]) == Ext<Int, K>(circuitOutput));
+
+    end = std::chrono::high_resolution_clock::now();
+    double verifierTime = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    delete[] op0;
+    delete[] op1;
+
+    return FLPCPMeasurement(proof.GetBytes(), queries.size(), proverTime * 1e-6, verifierTime * 1e-6, isValid);
+}
+
 template <typename Int> void TwoPC<Int>::ExperimentFLPCP(size_t nCases, size_t nExperiments)
 {
     constexpr uint32_t seed = 23571113;
@@ -315,27 +369,113 @@ template <typename Int> void TwoPC<Int>::ExperimentFLPCP(size_t nCases, size_t n
     delete[] coefficientVersion;
 }
 
+// Base field challenge against challenges in Ext<Int, 2> and Ext<Int, 3>, for input lengths and G-gates from 2 to 2^nCases
+template <typename Int> void TwoPC<Int>::ExperimentFLPCPExtensionChallenge(size_t nCases, size_t nExperiments)
+{
+    constexpr uint32_t seed = 23571113;
+    const size_t last = pow(2, nCases);
+
+    std::cout << "Simulating FLPCP with challenges in the base field, Ext<Int, 2> and Ext<Int, 3> " << nExperiments
+              << " times for input vector lengths from 2 to " << last << "." << std::endl;
+
+    FLPCPMeasurement* baseline = new FLPCPMeasurement[nCases];
+    FLPCPMeasurement* quadratic = new FLPCPMeasurement[nCases];
+    FLPCPMeasurement* cubic = new FLPCPMeasurement[nCases];
+
+    for (size_t i = 1; i <= nCases; ++i)
+    {
+        size_t vectorLength = pow(2, i);
+
+        baseline[i - 1] = TwoPC<Int>::FLPCP(seed, vectorLength, vectorLength);
+        quadratic[i - 1] = TwoPC<Int>::FLPCPExtensionChallenge<2>(seed, vectorLength, vectorLength);
+        cubic[i - 1] = TwoPC<Int>::FLPCPExtensionChallenge<3>(seed, vectorLength, vectorLength);
+
+        for (size_t j = 0; j < nExperiments - 1; ++j)
+        {
+            baseline[i - 1] += TwoPC<Int>::FLPCP(seed, vectorLength, vectorLength);
+            quadratic[i - 1] += TwoPC<Int>::FLPCPExtensionChallenge<2>(seed, vectorLength, vectorLength);
+            cubic[i - 1] += TwoPC<Int>::FLPCPExtensionChallenge<3>(seed, vectorLength, vectorLength);
+        }
+
+        baseline[i - 1] /= nExperiments;
+        quadratic[i - 1] /= nExperiments;
+        cubic[i - 1] /= nExperiments;
+
+        if (!baseline[i - 1].isVaild || !quadratic[i - 1].isVaild || !cubic[i - 1].isVaild)
+        {
+            std::cout << "Invalid in FLPCP with extension challenges (" << vectorLength << ")" << std::endl;
+            delete[] baseline;
+            delete[] quadratic;
+            delete[] cubic;
+            return;
+        }
+    }
+
+    std::cout << std::endl;
+    std::cout << "[Simulation Results]" << std::endl;
+    std::cout << "Vector Length : ";
+    for (size_t i = 1; i <= nCases; ++i)
+    {
+        std::cout << (size_t)pow(2, i) << ", ";
+    }
+    std::cout << std::endl;
+    std::cout << std::endl;
+
+    const FLPCPMeasurement* const results[3] = {baseline, quadratic, cubic};
+    const char* const names[3] = {"Base field : ", "Ext<Int, 2> : ", "Ext<Int, 3> : "};
+    std::cout << "* Prover Time" << std::endl;
+    for (size_t k = 0; k < 3; ++k)
+    {
+        std::cout << names[k];
+        for (size_t i = 0; i < nCases; ++i)
+        {
+            std::cout << std::fixed << results[k][i].proverTime << std::setprecision(4) << ", ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+
+    std::cout << "* Verifier Time" << std::endl;
+    for (size_t k = 0; k < 3; ++k)
+    {
+        std::cout << names[k];
+        for (size_t i = 0; i < nCases; ++i)
+        {
+            std::cout << std::fixed << results[k][i].verifierTime << std::setprecision(4) << ", ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "------------------------------------------------------" << std::endl;
+
+    delete[] baseline;
+    delete[] quadratic;
+    delete[] cubic;
+}
+
 template <typename Int>
 FLIOPMeasurement TwoPC<Int>::FLIOP(const size_t seed, const size_t inputLength, const size_t compressFactor)
 {
     Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
 
     std::vector<Int> op0(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0.data(), inputLength);
     std::vector<Int> op1(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1.data(), inputLength);
+
+    return TwoPC<Int>::FLIOP(std::move(op0), std::move(op1), compressFactor);
+}
+
+template <typename Int>
+FLIOPMeasurement TwoPC<Int>::FLIOP(std::vector<Int> op0, std::vector<Int> op1, const size_t compressFactor)
+{
+    assert(op0.size() == op1.size());
 
     std::vector<Int> verOp0 = op0;
     std::vector<Int> verOp1 = op1;
 
     bool isValid = true;
-    Int out = InnerProductCircuit<Int>::Forward(op0.data(), op1.data(), inputLength);
+    Int out = InnerProductCircuit<Int>::Forward(op0.data(), op1.data(), op0.size());
 
     size_t totalProofSize = 0u;
     size_t totalQueryComplexity = 0u;
@@ -347,6 +487,7 @@ FLIOPMeasurement TwoPC<Int>::FLIOP(const size_t seed, const size_t inputLength,
     randoms.reserve(nTotalRounds);
 
     // Prover
+    OperationCounter::BeginPhase("prover");
     auto start = std::chrono::high_resolution_clock::now();
     while (ceil(op0.size() / (double)compressFactor) > 1)
     {
@@ -368,10 +509,13 @@ FLIOPMeasurement TwoPC<Int>::FLIOP(const size_t seed, const size_t inputLength,
     assert(interactiveProofs.size() == randoms.size());
 
     // Communication
-    double LANTime = Network::GetLANDelay(totalProofSize + nTotalRounds * sizeof(Int) + op0.size() * 2 * sizeof(Int));
-    double WANTime = Network::GetWANDelay(totalProofSize + nTotalRounds * sizeof(Int) + op0.size() * 2 * sizeof(Int));
+    const size_t randomBytes = PackedCodec<Int>::GetPackedBytes(nTotalRounds);
+    const size_t finalInputBytes = PackedCodec<Int>::GetPackedBytes(op0.size() * 2);
+    double LANTime = Network::GetLANDelay(totalProofSize + randomBytes + finalInputBytes);
+    double WANTime = Network::GetWANDelay(totalProofSize + randomBytes + finalInputBytes);
 
     // Verifier
+    OperationCounter::BeginPhase("verifier");
     start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < interactiveProofs.size(); ++i)
     {
@@ -381,46 +525,27 @@ FLIOPMeasurement TwoPC<Int>::FLIOP(const size_t seed, const size_t inputLength,
         isValid = isValid && (out == interactiveProofs[i].GetQueryAnswer(queries[0]));
         out = interactiveProofs[i].GetQueryAnswer(queries[1]);
 
-        // Compressing
-        const size_t nPoly0 = ceil(verOp0.size() / (double)compressFactor);
-        Int* const resizedInput0 = new Int[nPoly0 * compressFactor];
-        std::memset(resizedInput0, 0, (nPoly0 * compressFactor) * sizeof(Int));
-        std::memcpy(resizedInput0, verOp0.data(), verOp0.size() * sizeof(Int));
-        std::vector<Polynomial<Int>> poly0s;
-        poly0s.reserve(nPoly0);
-        for (size_t j = 0; j < nPoly0; ++j)
-        {
-            poly0s.emplace_back(
-                Polynomial<Int>::LagrangeInterpolation(resizedInput0 + compressFactor * j, compressFactor));
-        }
-        delete[] resizedInput0;
+        // Compressing : every chunk of compressFactor values is evaluated at the challenge, the last one zero-padded
+        std::vector<Int> weights(compressFactor);
+        BarycentricEvaluator<Int>::CopyWeights(weights.data(), randoms[i], compressFactor);
 
+        const size_t nPoly0 = ceil(verOp0.size() / (double)compressFactor);
         std::vector<Int> newOp0;
         newOp0.reserve(nPoly0);
         for (size_t j = 0; j < nPoly0; ++j)
         {
-            newOp0.push_back(poly0s[j].Evaluate(randoms[i]));
+            const size_t length = std::min(compressFactor, verOp0.size() - compressFactor * j);
+            newOp0.push_back(VectorKernel<Int>::Dot(weights.data(), verOp0.data() + compressFactor * j, length));
         }
         verOp0 = newOp0;
 
         const size_t nPoly1 = ceil(verOp1.size() / (double)compressFactor);
-        Int* const resizedInput1 = new Int[nPoly1 * compressFactor];
-        std::memset(resizedInput1, 0, (nPoly1 * compressFactor) * sizeof(Int));
-        std::memcpy(resizedInput1, verOp1.data(), verOp1.size() * sizeof(Int));
-        std::vector<Polynomial<Int>> poly1s;
-        poly1s.reserve(nPoly1);
-        for (size_t j = 0; j < nPoly1; ++j)
-        {
-            poly1s.emplace_back(
-                Polynomial<Int>::LagrangeInterpolation(resizedInput1 + compressFactor * j, compressFactor));
-        }
-        delete[] resizedInput1;
-
         std::vector<Int> newOp1;
         newOp1.reserve(nPoly1);
         for (size_t j = 0; j < nPoly1; ++j)
         {
-            newOp1.push_back(poly1s[j].Evaluate(randoms[i]));
+            const size_t length = std::min(compressFactor, verOp1.size() - compressFactor * j);
+            newOp1.push_back(VectorKernel<Int>::Dot(weights.data(), verOp1.data() + compressFactor * j, length));
         }
         verOp1 = newOp1;
 
@@ -433,9 +558,8 @@ FLIOPMeasurement TwoPC<Int>::FLIOP(const size_t seed, const size_t inputLength,
     std::vector<Int> finalProverRandoms = finalProof.GetRandoms(2);
     verOp0.insert(verOp0.begin(), finalProverRandoms[0]);
     verOp1.insert(verOp1.begin(), finalProverRandoms[1]);
-    Polynomial<Int> finalOp0 = Polynomial<Int>::LagrangeInterpolation(verOp0.data(), verOp0.size());
-    Polynomial<Int> finalOp1 = Polynomial<Int>::LagrangeInterpolation(verOp1.data(), verOp1.size());
-    Int gR = finalOp0.Evaluate(finalVerifierRandom) * finalOp1.Evaluate(finalVerifierRandom);
+    Int gR = BarycentricEvaluator<Int>::Evaluate(verOp0.data(), verOp0.size(), finalVerifierRandom) *
+             BarycentricEvaluator<Int>::Evaluate(verOp1.data(), verOp1.size(), finalVerifierRandom);
     isValid = isValid && (finalProof.GetQueryAnswer(queries[queries.size() - 2]) == gR) &&
               (finalProof.GetQueryAnswer(queries[queries.size() - 1]) == out);
 
@@ -448,22 +572,41 @@ FLIOPMeasurement TwoPC<Int>::FLIOP(const size_t seed, const size_t inputLength,
                             LANTime * 1e-6, WANTime * 1e-6, isValid);
 }
 
+/*
+ * K-fold parallel repetition of FLIOP over the same inputs, raising the soundness error of every round to the K-th power.
+ * Repetitions run as the lanes of Lanes<Int, K>, so every pass over the inputs and proofs folds, queries and evaluates
+ * all of them at once, each with its own challenges.
+ */
+template <typename Int>
+template <size_t K>
+FLIOPMeasurement TwoPC<Int>::FLIOPParallelRepetition(const size_t seed, const size_t inputLength,
+                                                     const size_t compressFactor)
+{
+    Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
+
+    std::vector<Int> op0(inputLength);
+    Int::FillRandom(op0.data(), inputLength);
+    std::vector<Int> op1(inputLength);
+    Int::FillRandom(op1.data(), inputLength);
+
+    std::vector<Lanes<Int, K>> repeatedOp0(op0.begin(), op0.end());
+    std::vector<Lanes<Int, K>> repeatedOp1(op1.begin(), op1.end());
+
+    return TwoPC<Lanes<Int, K>>::FLIOP(std::move(repeatedOp0), std::move(repeatedOp1), compressFactor);
+}
+
 template <typename Int>
 FLIOPMeasurement TwoPC<Int>::FLIOPWithPrecompute(const size_t seed, const size_t inputLength,
                                                  const size_t compressFactor)
 {
     Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
 
     std::vector<Int> op0(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0.data(), inputLength);
     std::vector<Int> op1(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1.data(), inputLength);
 
     std::vector<Int> verOp0 = op0;
     std::vector<Int> verOp1 = op1;
@@ -490,6 +633,7 @@ FLIOPMeasurement TwoPC<Int>::FLIOPWithPrecompute(const size_t seed, const size_t
     SquareMatrix<Int> finalVanInv = SquareMatrix<Int>::GetVandermondeInverse(finalRoundLength + 1);
 
     // Prover
+    OperationCounter::BeginPhase("prover");
     auto start = std::chrono::high_resolution_clock::now();
     while (ceil(op0.size() / (double)compressFactor) > 1)
     {
@@ -511,10 +655,13 @@ FLIOPMeasurement TwoPC<Int>::FLIOPWithPrecompute(const size_t seed, const size_t
     assert(interactiveProofs.size() == randoms.size());
 
     // Communication
-    double LANTime = Network::GetLANDelay(totalProofSize + nTotalRounds * sizeof(Int) + op0.size() * 2 * sizeof(Int));
-    double WANTime = Network::GetWANDelay(totalProofSize + nTotalRounds * sizeof(Int) + op0.size() * 2 * sizeof(Int));
+    const size_t randomBytes = PackedCodec<Int>::GetPackedBytes(nTotalRounds);
+    const size_t finalInputBytes = PackedCodec<Int>::GetPackedBytes(op0.size() * 2);
+    double LANTime = Network::GetLANDelay(totalProofSize + randomBytes + finalInputBytes);
+    double WANTime = Network::GetWANDelay(totalProofSize + randomBytes + finalInputBytes);
 
     // Verifier
+    OperationCounter::BeginPhase("verifier");
     start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < interactiveProofs.size(); ++i)
     {
@@ -595,17 +742,12 @@ template <typename Int>
 FLIOPMeasurement TwoPC<Int>::FLIOPCoefficient(const size_t seed, const size_t inputLength, const size_t compressFactor)
 {
     Int::SetSeed(seed);
+    OperationCounter::BeginPhase("setup");
 
     std::vector<Int> op0(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op0[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op0.data(), inputLength);
     std::vector<Int> op1(inputLength);
-    for (size_t i = 0; i < inputLength; ++i)
-    {
-        op1[i] = Int::GenerateRandom();
-    }
+    Int::FillRandom(op1.data(), inputLength);
 
     std::vector<Int> verOp0 = op0;
     std::vector<Int> verOp1 = op1;
@@ -623,6 +765,7 @@ FLIOPMeasurement TwoPC<Int>::FLIOPCoefficient(const size_t seed, const size_t in
     randoms.reserve(nTotalRounds);
 
     // Prover
+    OperationCounter::BeginPhase("prover");
     auto start = std::chrono::high_resolution_clock::now();
     while (ceil(op0.size() / (double)compressFactor) > 1)
     {
@@ -644,10 +787,13 @@ FLIOPMeasurement TwoPC<Int>::FLIOPCoefficient(const size_t seed, const size_t in
     assert(interactiveProofs.size() == randoms.size());
 
     // Communication
-    double LANTime = Network::GetLANDelay(totalProofSize + nTotalRounds * sizeof(Int) + op0.size() * 2 * sizeof(Int));
-    double WANTime = Network::GetWANDelay(totalProofSize + nTotalRounds * sizeof(Int) + op0.size() * 2 * sizeof(Int));
+    const size_t randomBytes = PackedCodec<Int>::GetPackedBytes(nTotalRounds);
+    const size_t finalInputBytes = PackedCodec<Int>::GetPackedBytes(op0.size() * 2);
+    double LANTime = Network::GetLANDelay(totalProofSize + randomBytes + finalInputBytes);
+    double WANTime = Network::GetWANDelay(totalProofSize + randomBytes + finalInputBytes);
 
     // Verifier
+    OperationCounter::BeginPhase("verifier");
     start = std::chrono::high_resolution_clock::now();
     for (size_t i = 0; i < interactiveProofs.size(); ++i)
     {
@@ -881,4 +1027,104 @@ template <typename Int> void TwoPC<Int>::ExperimentFLIOP(size_t nCases, size_t n
     delete[] coefficientVersion;
 }
 
+// K repetitions of FLIOP as the lanes of one run against K separate runs, over the same inputs
+template <typename Int>
+template <size_t K>
+void TwoPC<Int>::ExperimentParallelRepetition(const size_t inputLength, const size_t compressFactor,
+                                              size_t nExperiments)
+{
+    constexpr uint32_t seed = 23571113;
+
+    std::cout << "Simulating " << K << "-fold FLIOP repetition " << nExperiments << " times for input vector length "
+              << inputLength << " and compression factor " << compressFactor << "." << std::endl;
+
+    FLIOPMeasurement parallel = TwoPC<Int>::FLIOPParallelRepetition<K>(seed, inputLength, compressFactor);
+    bool isParallelValid = parallel.isVaild;
+    FLIOPMeasurement sequential = TwoPC<Int>::FLIOP(seed, inputLength, compressFactor);
+    bool isSequentialValid = sequential.isVaild;
+    for (size_t k = 1; k < K; ++k)
+    {
+        FLIOPMeasurement repetition = TwoPC<Int>::FLIOP(seed, inputLength, compressFactor);
+        isSequentialValid = isSequentialValid && repetition.isVaild;
+        sequential += repetition;
+    }
+
+    for (size_t j = 0; j < nExperiments - 1; ++j)
+    {
+        FLIOPMeasurement repetition = TwoPC<Int>::FLIOPParallelRepetition<K>(seed, inputLength, compressFactor);
+        isParallelValid = isParallelValid && repetition.isVaild;
+        parallel += repetition;
+        for (size_t k = 0; k < K; ++k)
+        {
+            repetition = TwoPC<Int>::FLIOP(seed, inputLength, compressFactor);
+            isSequentialValid = isSequentialValid && repetition.isVaild;
+            sequential += repetition;
+        }
+    }
+
+    parallel /= nExperiments;
+    sequential /= nExperiments;
+
+    std::cout << "[Simulation Results]" << std::endl;
+    std::cout << "Validity : " << K << " lanes " << isParallelValid << ", " << K << " runs " << isSequentialValid
+              << std::endl;
+    std::cout << "Proof Length : " << K << " lanes " << parallel.proofLength << ", " << K << " runs "
+              << K * sequential.proofLength << std::endl;
+    std::cout << "Prover Time : " << K << " lanes " << std::fixed << std::setprecision(4) << parallel.proverTime
+              << ", " << K << " runs " << sequential.proverTime << std::endl;
+    std::cout << "Verifier Time : " << K << " lanes " << std::fixed << std::setprecision(4) << parallel.verifierTime
+              << ", " << K << " runs " << sequential.verifierTime << std::endl;
+    std::cout << "------------------------------------------------------" << std::endl;
+}
+
+template <typename Int>
+void TwoPC<Int>::ExperimentOperationCounts(const size_t inputLength, const size_t nGGate, const size_t compressFactor)
+{
+    constexpr uint32_t seed = 23571113;
+
+    std::cout << "Counting operations of FLPCP (baseline, precomputed, coefficient) for input vector length "
+              << inputLength << " and " << nGGate << " G-gates, and FLIOP (baseline, precomputed, coefficient) for "
+              << "compression factor " << compressFactor << "." << std::endl;
+
+    bool isValid = true;
+
+    OperationCounter::Reset();
+    isValid = TwoPC<Int>::FLPCP(seed, inputLength, nGGate).isVaild && isValid;
+    std::cout << "* FLPCP Baseline" << std::endl;
+    OperationCounter::PrintReport();
+
+    OperationCounter::Reset();
+    isValid = TwoPC<Int>::FLPCPWithPrecompute(seed, inputLength, nGGate).isVaild && isValid;
+    std::cout << "* FLPCP Precomputed" << std::endl;
+    OperationCounter::PrintReport();
+
+    OperationCounter::Reset();
+    isValid = TwoPC<Int>::FLPCPCoefficient(seed, inputLength, nGGate).isVaild && isValid;
+    std::cout << "* FLPCP Coefficient" << std::endl;
+    OperationCounter::PrintReport();
+
+    OperationCounter::Reset();
+    isValid = TwoPC<Int>::FLIOP(seed, inputLength, compressFactor).isVaild && isValid;
+    std::cout << "* FLIOP Baseline" << std::endl;
+    OperationCounter::PrintReport();
+
+    OperationCounter::Reset();
+    isValid = TwoPC<Int>::FLIOPWithPrecompute(seed, inputLength, compressFactor).isVaild && isValid;
+    std::cout << "* FLIOP Precomputed" << std::endl;
+    OperationCounter::PrintReport();
+
+    OperationCounter::Reset();
+    isValid = TwoPC<Int>::FLIOPCoefficient(seed, inputLength, compressFactor).isVaild && isValid;
+    std::cout << "* FLIOP Coefficient" << std::endl;
+    OperationCounter::PrintReport();
+
+    OperationCounter::Reset();
+
+    if (!isValid)
+    {
+        std::cout << "Some proofs are invalid!!!!" << std::endl;
+    }
+    std::cout << "------------------------------------------------------" << std::endl;
+}
+
 #endif
@@ -1,13 +1,44 @@
-﻿#include "math\mpint64.hpp"
+﻿#include "math\counting_int.hpp"
+#include "math\gf2_64.hpp"
+#include "math\mpint32.hpp"
+#include "math\mpint64.hpp"
 #include "experiments\two_party_computation.hpp"
 #include "experiments\multi_party_computation.hpp"
+#include "experiments\performance_measurement.hpp"
 
 #include "math\sha512.hpp"
 
+#include <string>
+
+// Runs the experiment named by the first argument, or the FLIOP schedule search without one
 int main(int argc, char* argv[])
 {
-    MPC<Mpint64> mpc(23571113, 65536, 64, 6);
-    mpc.FindBestFLIOPSchedule(false, 100);
+    const std::string experiment = argc > 1 ? argv[1] : "";
+    if (experiment == "flpcp")
+    {
+        TwoPC<Mpint64>::ExperimentFLPCP(10, 10);
+        TwoPC<Mpint64>::ExperimentFLPCPExtensionChallenge(10, 10);
+    }
+    else if (experiment == "parallel-repetition")
+    {
+        TwoPC<Mpint32>::ExperimentParallelRepetition<4>(65536, 8, 10);
+        TwoPC<Mpint64>::ExperimentParallelRepetition<2>(65536, 8, 10);
+    }
+    else if (experiment == "soundness-fields")
+    {
+        PerformanceMeasurement::CompareSoundnessFields();
+        TwoPC<Mpint64>::ExperimentFLIOP(8, 10);
+        TwoPC<GF2_64>::ExperimentFLIOP(8, 10);
+    }
+    else if (experiment == "operation-counts")
+    {
+        TwoPC<CountingInt<Mpint64>>::ExperimentOperationCounts(1024, 32, 8);
+    }
+    else
+    {
+        MPC<Mpint64> mpc(23571113, 65536, 64, 6);
+        mpc.FindBestFLIOPSchedule(false, 100);
+    }
     system("pause");
     return 0;
 }
@@ -0,0 +1,185 @@
+#ifndef ACCUMULATOR_H
+#define ACCUMULATOR_H
+
+#include <stdint.h>
+
+#include "../math/mpint32.hpp"
+#include "../math/mpint64.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/* Sum of products with deferred modular reduction */
+template <typename Int> class Accumulator
+{
+public:
+    Accumulator();
+
+    void MultiplyAdd(const Int& op0, const Int& op1);
+    void Add(const Int& op);
+    Int Get() const;
+
+private:
+    Int mValue;
+};
+
+/*
+ * Z_{2^61 - 1} : products are summed in 128 bits and folded once every FOLD_INTERVAL terms.
+ * Terms are read as stored, so the interval leaves room for values below 2p under a lazy policy.
+ */
+template <typename Policy> class Accumulator<BasicMpint64<Policy>>
+{
+public:
+    static constexpr size_t INPUT_BITS = Policy::IS_CANONICAL ? 61 : 62;
+    static constexpr size_t FOLD_INTERVAL = ((size_t)1 << (128 - 2 * INPUT_BITS)) - 1;
+
+    Accumulator();
+
+    void MultiplyAdd(const BasicMpint64<Policy>& op0, const BasicMpint64<Policy>& op1);
+    void Add(const BasicMpint64<Policy>& op);
+    BasicMpint64<Policy> Get() const;
+
+private:
+    static constexpr uint64_t BASE = BasicMpint64<Policy>::GetBase();
+
+    uint64_t mLow;
+    uint64_t mHigh;
+    size_t mCount;
+
+    void AddWide(uint64_t low, uint64_t high);
+    uint64_t Fold() const;
+};
+
+/* Z_{2^31 - 1} : canonical products (< 2^62) are summed in 64 bits and folded once every FOLD_INTERVAL terms */
+template <typename Policy> class Accumulator<BasicMpint32<Policy>>
+{
+public:
+    static constexpr size_t FOLD_INTERVAL = ((size_t)1 << (64 - 2 * 31)) - 1;
+
+    Accumulator();
+
+    void MultiplyAdd(const BasicMpint32<Policy>& op0, const BasicMpint32<Policy>& op1);
+    void Add(const BasicMpint32<Policy>& op);
+    BasicMpint32<Policy> Get() const;
+
+private:
+    static constexpr uint64_t BASE = BasicMpint32<Policy>::GetBase();
+
+    uint64_t mSum;
+    size_t mCount;
+
+    uint64_t Fold() const;
+};
+
+template <typename Int> Accumulator<Int>::Accumulator() : mValue((uint64_t)0)
+{
+}
+
+template <typename Int> void Accumulator<Int>::MultiplyAdd(const Int& op0, const Int& op1)
+{
+    mValue += op0 * op1;
+}
+
+template <typename Int> void Accumulator<Int>::Add(const Int& op)
+{
+    mValue += op;
+}
+
+template <typename Int> Int Accumulator<Int>::Get() const
+{
+    return mValue;
+}
+
+/* Accumulator<BasicMpint64> */
+
+template <typename Policy> Accumulator<BasicMpint64<Policy>>::Accumulator() : mLow(0u), mHigh(0u), mCount(0u)
+{
+}
+
+template <typename Policy>
+void Accumulator<BasicMpint64<Policy>>::MultiplyAdd(const BasicMpint64<Policy>& op0, const BasicMpint64<Policy>& op1)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    uint64_t high;
+    uint64_t low = _umul128(op0.GetRepresentation(), op1.GetRepresentation(), &high);
+    AddWide(low, high);
+#else
+    unsigned __int128 product = (unsigned __int128)op0.GetRepresentation() * op1.GetRepresentation();
+    AddWide((uint64_t)product, (uint64_t)(product >> 64));
+#endif
+}
+
+template <typename Policy> void Accumulator<BasicMpint64<Policy>>::Add(const BasicMpint64<Policy>& op)
+{
+    AddWide(op.GetRepresentation(), 0u);
+}
+
+template <typename Policy> BasicMpint64<Policy> Accumulator<BasicMpint64<Policy>>::Get() const
+{
+    return BasicMpint64<Policy>(Fold());
+}
+
+template <typename Policy> void Accumulator<BasicMpint64<Policy>>::AddWide(uint64_t low, uint64_t high)
+{
+    if (mCount == FOLD_INTERVAL)
+    {
+        mLow = Fold();
+        mHigh = 0u;
+        mCount = 0u;
+    }
+
+    mLow += low;
+    mHigh += high + (mLow < low ? 1u : 0u);
+    ++mCount;
+}
+
+template <typename Policy> uint64_t Accumulator<BasicMpint64<Policy>>::Fold() const
+{
+    // 2^64 = 8, 2^61 = 1 (mod 2^61 - 1) : the result is below 2^63
+    return (mLow & BASE) + (mLow >> 61) + ((mHigh << 3) & BASE) + (mHigh >> 58);
+}
+
+/* Accumulator<BasicMpint32> */
+
+template <typename Policy> Accumulator<BasicMpint32<Policy>>::Accumulator() : mSum(0u), mCount(0u)
+{
+}
+
+template <typename Policy>
+void Accumulator<BasicMpint32<Policy>>::MultiplyAdd(const BasicMpint32<Policy>& op0, const BasicMpint32<Policy>& op1)
+{
+    if (mCount == FOLD_INTERVAL)
+    {
+        mSum = Fold();
+        mCount = 0u;
+    }
+
+    mSum += (uint64_t)op0.GetValue() * op1.GetValue();
+    ++mCount;
+}
+
+template <typename Policy> void Accumulator<BasicMpint32<Policy>>::Add(const BasicMpint32<Policy>& op)
+{
+    if (mCount == FOLD_INTERVAL)
+    {
+        mSum = Fold();
+        mCount = 0u;
+    }
+
+    mSum += op.GetValue();
+    ++mCount;
+}
+
+template <typename Policy> BasicMpint32<Policy> Accumulator<BasicMpint32<Policy>>::Get() const
+{
+    return BasicMpint32<Policy>(Fold());
+}
+
+template <typename Policy> uint64_t Accumulator<BasicMpint32<Policy>>::Fold() const
+{
+    // 2^31 = 1 (mod 2^31 - 1) : the result is below 2^34
+    return (mSum & BASE) + (mSum >> 31);
+}
+
+#endif
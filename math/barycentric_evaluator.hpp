@@ -0,0 +1,62 @@
+#ifndef BARYCENTRIC_EVALUATOR_H
+#define BARYCENTRIC_EVALUATOR_H
+
+#include <cassert>
+
+#include "../math/constant_tables.hpp"
+#include "../math/vector_kernel.hpp"
+
+/*
+ * Evaluation at r of the polynomial of degree below k through the values y_0, ..., y_{k-1} at the nodes 0, ..., k - 1,
+ * without its coefficients : f(r) = sum_i y_i L_i(r), with L_i(r) = prod_{j != i} (r - j) / prod_{j != i} (i - j).
+ * Numerators are prefix and suffix products of r - j, so r may be a node, and the denominators come inverted from
+ * ConstantTables (factorial tables, or one batched inversion), in O(k) multiplications.
+ */
+template <typename Int> class BarycentricEvaluator
+{
+public:
+    // L_0(r), ..., L_{k-1}(r) : evaluating any values at r is then a dot product with them
+    static void CopyWeights(Int* dst, const Int r, const size_t nNodes);
+    // f(r) for values at the first nValues nodes of nNodes, the rest being zero
+    static Int Evaluate(const Int* values, const size_t nValues, const Int r, const size_t nNodes);
+    static Int Evaluate(const Int* values, const size_t nNodes, const Int r);
+};
+
+template <typename Int> void BarycentricEvaluator<Int>::CopyWeights(Int* dst, const Int r, const size_t nNodes)
+{
+    assert(nNodes > 0u);
+
+    ConstantTables<Int>::CopyLagrangeDenominatorInverses(dst, nNodes);
+    Int prefix((uint64_t)1);
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        dst[i] *= prefix;
+        prefix *= r - Int(i);
+    }
+    Int suffix((uint64_t)1);
+    for (size_t i = nNodes; i-- > 0;)
+    {
+        dst[i] *= suffix;
+        suffix *= r - Int(i);
+    }
+}
+
+template <typename Int>
+Int BarycentricEvaluator<Int>::Evaluate(const Int* values, const size_t nValues, const Int r, const size_t nNodes)
+{
+    assert(nValues <= nNodes);
+
+    Int* const weights = new Int[nNodes];
+    CopyWeights(weights, r, nNodes);
+    const Int value = VectorKernel<Int>::Dot(weights, values, nValues);
+    delete[] weights;
+
+    return value;
+}
+
+template <typename Int> Int BarycentricEvaluator<Int>::Evaluate(const Int* values, const size_t nNodes, const Int r)
+{
+    return Evaluate(values, nNodes, r, nNodes);
+}
+
+#endif
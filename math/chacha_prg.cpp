@@ -0,0 +1,161 @@
+#include <stdint.h>
+
+#include "chacha_prg.hpp"
+#include "cpu_features.hpp"
+
+#if defined(CPU_FEATURES_X86)
+#include <immintrin.h>
+#endif
+
+static const size_t N_DOUBLE_ROUNDS = 6; // ChaCha12
+
+static inline uint32_t RotateLeft(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+static inline void QuarterRound(uint32_t* x, size_t a, size_t b, size_t c, size_t d)
+{
+    x[a] += x[b];
+    x[d] = RotateLeft(x[d] ^ x[a], 16);
+    x[c] += x[d];
+    x[b] = RotateLeft(x[b] ^ x[c], 12);
+    x[a] += x[b];
+    x[d] = RotateLeft(x[d] ^ x[a], 8);
+    x[c] += x[d];
+    x[b] = RotateLeft(x[b] ^ x[c], 7);
+}
+
+static void GenerateBatchScalar(const uint32_t* input, uint64_t counter, uint32_t* out)
+{
+    for (size_t b = 0; b < ChaChaPrg::BLOCKS_PER_BATCH; ++b)
+    {
+        const uint64_t blockCounter = counter * ChaChaPrg::BLOCKS_PER_BATCH + b;
+
+        uint32_t state[16];
+        std::memcpy(state, input, sizeof(state));
+        state[12] = (uint32_t)blockCounter;
+        state[13] = (uint32_t)(blockCounter >> 32);
+
+        uint32_t x[16];
+        std::memcpy(x, state, sizeof(x));
+        for (size_t i = 0; i < N_DOUBLE_ROUNDS; ++i)
+        {
+            QuarterRound(x, 0, 4, 8, 12);
+            QuarterRound(x, 1, 5, 9, 13);
+            QuarterRound(x, 2, 6, 10, 14);
+            QuarterRound(x, 3, 7, 11, 15);
+            QuarterRound(x, 0, 5, 10, 15);
+            QuarterRound(x, 1, 6, 11, 12);
+            QuarterRound(x, 2, 7, 8, 13);
+            QuarterRound(x, 3, 4, 9, 14);
+        }
+
+        for (size_t i = 0; i < 16; ++i)
+        {
+            out[i * ChaChaPrg::BLOCKS_PER_BATCH + b] = x[i] + state[i];
+        }
+    }
+}
+
+#if defined(CPU_FEATURES_X86)
+
+/* AVX2 backend : block b of the batch lives in lane b of every register */
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i RotateLeft16x8(__m256i x)
+{
+    const __m256i shuffle = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4,
+                                             5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i RotateLeft8x8(__m256i x)
+{
+    const __m256i shuffle = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5,
+                                             6, 11, 8, 9, 10, 15, 12, 13, 14);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+
+CPU_FEATURES_TARGET("avx2") static inline void QuarterRoundx8(__m256i* x, size_t a, size_t b, size_t c, size_t d)
+{
+    x[a] = _mm256_add_epi32(x[a], x[b]);
+    x[d] = RotateLeft16x8(_mm256_xor_si256(x[d], x[a]));
+    x[c] = _mm256_add_epi32(x[c], x[d]);
+    x[b] = _mm256_xor_si256(x[b], x[c]);
+    x[b] = _mm256_or_si256(_mm256_slli_epi32(x[b], 12), _mm256_srli_epi32(x[b], 20));
+    x[a] = _mm256_add_epi32(x[a], x[b]);
+    x[d] = RotateLeft8x8(_mm256_xor_si256(x[d], x[a]));
+    x[c] = _mm256_add_epi32(x[c], x[d]);
+    x[b] = _mm256_xor_si256(x[b], x[c]);
+    x[b] = _mm256_or_si256(_mm256_slli_epi32(x[b], 7), _mm256_srli_epi32(x[b], 25));
+}
+
+CPU_FEATURES_TARGET("avx2") static void GenerateBatchAvx2(const uint32_t* input, uint64_t counter, uint32_t* out)
+{
+    alignas(32) uint32_t counterLow[ChaChaPrg::BLOCKS_PER_BATCH];
+    alignas(32) uint32_t counterHigh[ChaChaPrg::BLOCKS_PER_BATCH];
+    for (size_t b = 0; b < ChaChaPrg::BLOCKS_PER_BATCH; ++b)
+    {
+        const uint64_t blockCounter = counter * ChaChaPrg::BLOCKS_PER_BATCH + b;
+        counterLow[b] = (uint32_t)blockCounter;
+        counterHigh[b] = (uint32_t)(blockCounter >> 32);
+    }
+
+    __m256i state[16];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        state[i] = _mm256_set1_epi32((int)input[i]);
+    }
+    state[12] = _mm256_load_si256((const __m256i*)counterLow);
+    state[13] = _mm256_load_si256((const __m256i*)counterHigh);
+
+    __m256i x[16];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        x[i] = state[i];
+    }
+    for (size_t i = 0; i < N_DOUBLE_ROUNDS; ++i)
+    {
+        QuarterRoundx8(x, 0, 4, 8, 12);
+        QuarterRoundx8(x, 1, 5, 9, 13);
+        QuarterRoundx8(x, 2, 6, 10, 14);
+        QuarterRoundx8(x, 3, 7, 11, 15);
+        QuarterRoundx8(x, 0, 5, 10, 15);
+        QuarterRoundx8(x, 1, 6, 11, 12);
+        QuarterRoundx8(x, 2, 7, 8, 13);
+        QuarterRoundx8(x, 3, 4, 9, 14);
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        _mm256_storeu_si256((__m256i*)(out + i * ChaChaPrg::BLOCKS_PER_BATCH), _mm256_add_epi32(x[i], state[i]));
+    }
+}
+
+#endif
+
+typedef void (*BatchGenerator)(const uint32_t* input, uint64_t counter, uint32_t* out);
+
+static BatchGenerator GetBatchGenerator()
+{
+    static const BatchGenerator generator = []() {
+#if defined(CPU_FEATURES_X86)
+        if (CpuFeatures::GetSimdLevel() != SimdLevel::Scalar)
+        {
+            return &GenerateBatchAvx2;
+        }
+#endif
+        return &GenerateBatchScalar;
+    }();
+    return generator;
+}
+
+void ChaChaPrg::GenerateBatch(const uint32_t* input, uint64_t counter, uint32_t* out)
+{
+    GetBatchGenerator()(input, counter, out);
+}
+
+const char* ChaChaPrg::GetBackendName()
+{
+    return GetBatchGenerator() == &GenerateBatchScalar ? "scalar" : "avx2";
+}
@@ -0,0 +1,182 @@
+#ifndef CHACHA_PRG_H
+#define CHACHA_PRG_H
+
+#include <atomic>
+#include <cstring>
+#include <stdint.h>
+
+/*
+ * Counter-based pseudorandom generator on the ChaCha12 block function.
+ * A (seed, stream) pair selects an independent keystream; the counter makes any position reachable in O(1).
+ * Keystream is produced in batches of 8 blocks so that the SIMD backend (chacha_prg.cpp) runs one block per lane.
+ */
+class ChaChaPrg
+{
+public:
+    static constexpr size_t BLOCKS_PER_BATCH = 8;
+    static constexpr size_t WORDS_PER_BATCH = BLOCKS_PER_BATCH * 16;
+
+    ChaChaPrg();
+    ChaChaPrg(uint64_t seed, uint64_t stream);
+
+    void SetSeed(uint64_t seed, uint64_t stream);
+    void Jump(uint64_t nBatches); // Drop the rest of the current batch and skip nBatches batches
+
+    uint32_t Next32();
+    uint64_t Next64();
+    void Fill(uint32_t* words, size_t length);
+    void Fill(uint64_t* words, size_t length);
+
+    // Every thread owns a stream of the global seed, so sampling needs no locking
+    static void SetGlobalSeed(uint64_t seed);
+    static ChaChaPrg& GetThreadLocal();
+
+    static const char* GetBackendName();
+
+private:
+    static std::atomic<uint64_t> sGlobalSeed;
+    static std::atomic<uint64_t> sGlobalEpoch;
+    static std::atomic<uint64_t> sNextStream;
+
+    uint32_t mInput[16];
+    uint64_t mCounter; // Index of the next batch
+    uint32_t mBuffer[WORDS_PER_BATCH];
+    size_t mPosition;
+
+    void FillBytes(unsigned char* bytes, size_t nBytes);
+    void Refill();
+
+    // Writes word i of block b (counter * 8 + b) to out[i * 8 + b]
+    static void GenerateBatch(const uint32_t* input, uint64_t counter, uint32_t* out);
+    static uint64_t SplitMix64(uint64_t& state);
+};
+
+/* Initialize static members */
+inline std::atomic<uint64_t> ChaChaPrg::sGlobalSeed = 0u;
+inline std::atomic<uint64_t> ChaChaPrg::sGlobalEpoch = 1u;
+inline std::atomic<uint64_t> ChaChaPrg::sNextStream = 0u;
+
+/* Define member functions */
+inline ChaChaPrg::ChaChaPrg()
+{
+    SetSeed(0u, 0u);
+}
+
+inline ChaChaPrg::ChaChaPrg(uint64_t seed, uint64_t stream)
+{
+    SetSeed(seed, stream);
+}
+
+inline void ChaChaPrg::SetSeed(uint64_t seed, uint64_t stream)
+{
+    // "expand 32-byte k"
+    mInput[0] = 0x61707865;
+    mInput[1] = 0x3320646e;
+    mInput[2] = 0x79622d32;
+    mInput[3] = 0x6b206574;
+
+    uint64_t state = seed;
+    for (size_t i = 4; i < 12; i += 2)
+    {
+        const uint64_t key = SplitMix64(state);
+        mInput[i] = (uint32_t)key;
+        mInput[i + 1] = (uint32_t)(key >> 32);
+    }
+
+    mInput[12] = 0u; // Block counter, filled per block
+    mInput[13] = 0u;
+    mInput[14] = (uint32_t)stream;
+    mInput[15] = (uint32_t)(stream >> 32);
+
+    mCounter = 0u;
+    mPosition = WORDS_PER_BATCH;
+}
+
+inline void ChaChaPrg::Jump(uint64_t nBatches)
+{
+    mPosition = WORDS_PER_BATCH;
+    mCounter += nBatches;
+}
+
+inline uint32_t ChaChaPrg::Next32()
+{
+    if (mPosition == WORDS_PER_BATCH)
+    {
+        Refill();
+    }
+    return mBuffer[mPosition++];
+}
+
+inline uint64_t ChaChaPrg::Next64()
+{
+    const uint64_t low = Next32();
+    const uint64_t high = Next32();
+    return low | (high << 32);
+}
+
+inline void ChaChaPrg::Fill(uint32_t* words, size_t length)
+{
+    FillBytes((unsigned char*)words, length * sizeof(uint32_t));
+}
+
+inline void ChaChaPrg::Fill(uint64_t* words, size_t length)
+{
+    FillBytes((unsigned char*)words, length * sizeof(uint64_t));
+}
+
+inline void ChaChaPrg::SetGlobalSeed(uint64_t seed)
+{
+    sGlobalSeed.store(seed, std::memory_order_relaxed);
+    sGlobalEpoch.fetch_add(1u, std::memory_order_release);
+}
+
+inline ChaChaPrg& ChaChaPrg::GetThreadLocal()
+{
+    thread_local ChaChaPrg prg;
+    thread_local uint64_t stream = sNextStream.fetch_add(1u, std::memory_order_relaxed);
+    thread_local uint64_t epoch = 0u;
+
+    // Reseed lazily once the global seed has changed since this thread last drew
+    const uint64_t globalEpoch = sGlobalEpoch.load(std::memory_order_acquire);
+    if (epoch != globalEpoch)
+    {
+        prg.SetSeed(sGlobalSeed.load(std::memory_order_relaxed), stream);
+        epoch = globalEpoch;
+    }
+    return prg;
+}
+
+inline void ChaChaPrg::FillBytes(unsigned char* bytes, size_t nBytes)
+{
+    while (nBytes > 0)
+    {
+        if (mPosition == WORDS_PER_BATCH)
+        {
+            Refill();
+        }
+        const size_t nAvailable = (WORDS_PER_BATCH - mPosition) * sizeof(uint32_t);
+        const size_t nCopy = nBytes < nAvailable ? nBytes : nAvailable;
+        std::memcpy(bytes, mBuffer + mPosition, nCopy);
+        // A partially consumed word is dropped so that the buffer stays word aligned
+        mPosition += (nCopy + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+        bytes += nCopy;
+        nBytes -= nCopy;
+    }
+}
+
+inline void ChaChaPrg::Refill()
+{
+    GenerateBatch(mInput, mCounter, mBuffer);
+    ++mCounter;
+    mPosition = 0u;
+}
+
+inline uint64_t ChaChaPrg::SplitMix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+#endif
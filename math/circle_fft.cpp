@@ -0,0 +1,291 @@
+#include <cassert>
+#include <memory>
+#include <stdint.h>
+
+#include "circle_fft.hpp"
+#include "cpu_features.hpp"
+#include "extension_field.hpp"
+#include "vector_kernel.hpp"
+
+#if defined(CPU_FEATURES_X86)
+#include <immintrin.h>
+#endif
+
+static const uint32_t P31 = 0x7FFFFFFF; // 2^31 - 1
+
+/*
+ * One radix-2 layer over the whole array, on canonical words : the layer of half h pairs j with j + h in every block
+ * of 2h and takes its twiddles from [h, 2h) of the tables
+ */
+struct CircleBackend
+{
+    const char* name;
+    void (*forwardLayer)(uint32_t* real, uint32_t* imaginary, const uint32_t* twiddleReal,
+                         const uint32_t* twiddleImaginary, size_t size, size_t half);
+    void (*inverseLayer)(uint32_t* real, uint32_t* imaginary, const uint32_t* twiddleReal,
+                         const uint32_t* twiddleImaginary, size_t size, size_t half);
+};
+
+/* Scalar backend */
+
+static inline uint32_t Add31(uint32_t x, uint32_t y)
+{
+    const uint32_t sum = x + y;
+    return sum >= P31 ? sum - P31 : sum;
+}
+
+static inline uint32_t Sub31(uint32_t x, uint32_t y)
+{
+    return x >= y ? x - y : x + P31 - y;
+}
+
+static inline uint32_t Multiply31(uint32_t x, uint32_t y)
+{
+    const uint64_t product = (uint64_t)x * y;
+    const uint32_t folded = (uint32_t)(product & P31) + (uint32_t)(product >> 31);
+    return folded >= P31 ? folded - P31 : folded;
+}
+
+// (a - b) w for the difference a - b of the pair, and the sum in place of a
+static void ForwardLayerScalar(uint32_t* real, uint32_t* imaginary, const uint32_t* twiddleReal,
+                               const uint32_t* twiddleImaginary, size_t size, size_t half)
+{
+    for (size_t begin = 0; begin < size; begin += 2u * half)
+    {
+        for (size_t j = begin; j < begin + half; ++j)
+        {
+            const uint32_t differenceReal = Sub31(real[j], real[j + half]);
+            const uint32_t differenceImaginary = Sub31(imaginary[j], imaginary[j + half]);
+            real[j] = Add31(real[j], real[j + half]);
+            imaginary[j] = Add31(imaginary[j], imaginary[j + half]);
+
+            const uint32_t c = twiddleReal[half + j - begin];
+            const uint32_t d = twiddleImaginary[half + j - begin];
+            real[j + half] = Sub31(Multiply31(differenceReal, c), Multiply31(differenceImaginary, d));
+            imaginary[j + half] = Add31(Multiply31(differenceReal, d), Multiply31(differenceImaginary, c));
+        }
+    }
+}
+
+// a + b conj(w) and a - b conj(w), as conj(w) = w^-1 on the circle
+static void InverseLayerScalar(uint32_t* real, uint32_t* imaginary, const uint32_t* twiddleReal,
+                               const uint32_t* twiddleImaginary, size_t size, size_t half)
+{
+    for (size_t begin = 0; begin < size; begin += 2u * half)
+    {
+        for (size_t j = begin; j < begin + half; ++j)
+        {
+            const uint32_t c = twiddleReal[half + j - begin];
+            const uint32_t d = twiddleImaginary[half + j - begin];
+            const uint32_t productReal = Add31(Multiply31(real[j + half], c), Multiply31(imaginary[j + half], d));
+            const uint32_t productImaginary = Sub31(Multiply31(imaginary[j + half], c), Multiply31(real[j + half], d));
+
+            real[j + half] = Sub31(real[j], productReal);
+            imaginary[j + half] = Sub31(imaginary[j], productImaginary);
+            real[j] = Add31(real[j], productReal);
+            imaginary[j] = Add31(imaginary[j], productImaginary);
+        }
+    }
+}
+
+static const CircleBackend sScalarBackend = {"scalar", &ForwardLayerScalar, &InverseLayerScalar};
+
+#if defined(CPU_FEATURES_X86)
+
+/* AVX2 backend : 8 butterflies at a time, down to the layers of half 8 */
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Add31x8(__m256i x, __m256i y)
+{
+    // For a sum below 2p, sum - p wraps above it exactly when sum < p
+    const __m256i sum = _mm256_add_epi32(x, y);
+    return _mm256_min_epu32(sum, _mm256_sub_epi32(sum, _mm256_set1_epi32(P31)));
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Sub31x8(__m256i x, __m256i y)
+{
+    const __m256i difference = _mm256_sub_epi32(x, y);
+    return _mm256_min_epu32(difference, _mm256_add_epi32(difference, _mm256_set1_epi32(P31)));
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Multiply31x8(__m256i x, __m256i y)
+{
+    const __m256i p = _mm256_set1_epi64x(P31);
+    const __m256i productEven = _mm256_mul_epu32(x, y);
+    const __m256i productOdd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+    const __m256i even = _mm256_add_epi64(_mm256_and_si256(productEven, p), _mm256_srli_epi64(productEven, 31));
+    const __m256i odd = _mm256_add_epi64(_mm256_and_si256(productOdd, p), _mm256_srli_epi64(productOdd, 31));
+    const __m256i folded = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    return _mm256_min_epu32(folded, _mm256_sub_epi32(folded, _mm256_set1_epi32(P31)));
+}
+
+CPU_FEATURES_TARGET("avx2") static void ForwardLayerAvx2(uint32_t* real, uint32_t* imaginary,
+                                                          const uint32_t* twiddleReal,
+                                                          const uint32_t* twiddleImaginary, size_t size, size_t half)
+{
+    if (half < 8u)
+    {
+        ForwardLayerScalar(real, imaginary, twiddleReal, twiddleImaginary, size, half);
+        return;
+    }
+
+    for (size_t begin = 0; begin < size; begin += 2u * half)
+    {
+        for (size_t j = 0; j < half; j += 8u)
+        {
+            uint32_t* const xReal = real + begin + j;
+            uint32_t* const xImaginary = imaginary + begin + j;
+            const __m256i aReal = _mm256_loadu_si256((const __m256i*)xReal);
+            const __m256i aImaginary = _mm256_loadu_si256((const __m256i*)xImaginary);
+            const __m256i bReal = _mm256_loadu_si256((const __m256i*)(xReal + half));
+            const __m256i bImaginary = _mm256_loadu_si256((const __m256i*)(xImaginary + half));
+            const __m256i c = _mm256_loadu_si256((const __m256i*)(twiddleReal + half + j));
+            const __m256i d = _mm256_loadu_si256((const __m256i*)(twiddleImaginary + half + j));
+
+            const __m256i differenceReal = Sub31x8(aReal, bReal);
+            const __m256i differenceImaginary = Sub31x8(aImaginary, bImaginary);
+            _mm256_storeu_si256((__m256i*)xReal, Add31x8(aReal, bReal));
+            _mm256_storeu_si256((__m256i*)xImaginary, Add31x8(aImaginary, bImaginary));
+            _mm256_storeu_si256((__m256i*)(xReal + half),
+                                Sub31x8(Multiply31x8(differenceReal, c), Multiply31x8(differenceImaginary, d)));
+            _mm256_storeu_si256((__m256i*)(xImaginary + half),
+                                Add31x8(Multiply31x8(differenceReal, d), Multiply31x8(differenceImaginary, c)));
+        }
+    }
+}
+
+CPU_FEATURES_TARGET("avx2") static void InverseLayerAvx2(uint32_t* real, uint32_t* imaginary,
+                                                          const uint32_t* twiddleReal,
+                                                          const uint32_t* twiddleImaginary, size_t size, size_t half)
+{
+    if (half < 8u)
+    {
+        InverseLayerScalar(real, imaginary, twiddleReal, twiddleImaginary, size, half);
+        return;
+    }
+
+    for (size_t begin = 0; begin < size; begin += 2u * half)
+    {
+        for (size_t j = 0; j < half; j += 8u)
+        {
+            uint32_t* const xReal = real + begin + j;
+            uint32_t* const xImaginary = imaginary + begin + j;
+            const __m256i aReal = _mm256_loadu_si256((const __m256i*)xReal);
+            const __m256i aImaginary = _mm256_loadu_si256((const __m256i*)xImaginary);
+            const __m256i bReal = _mm256_loadu_si256((const __m256i*)(xReal + half));
+            const __m256i bImaginary = _mm256_loadu_si256((const __m256i*)(xImaginary + half));
+            const __m256i c = _mm256_loadu_si256((const __m256i*)(twiddleReal + half + j));
+            const __m256i d = _mm256_loadu_si256((const __m256i*)(twiddleImaginary + half + j));
+
+            const __m256i productReal = Add31x8(Multiply31x8(bReal, c), Multiply31x8(bImaginary, d));
+            const __m256i productImaginary = Sub31x8(Multiply31x8(bImaginary, c), Multiply31x8(bReal, d));
+            _mm256_storeu_si256((__m256i*)xReal, Add31x8(aReal, productReal));
+            _mm256_storeu_si256((__m256i*)xImaginary, Add31x8(aImaginary, productImaginary));
+            _mm256_storeu_si256((__m256i*)(xReal + half), Sub31x8(aReal, productReal));
+            _mm256_storeu_si256((__m256i*)(xImaginary + half), Sub31x8(aImaginary, productImaginary));
+        }
+    }
+}
+
+static const CircleBackend sAvx2Backend = {"avx2", &ForwardLayerAvx2, &InverseLayerAvx2};
+
+#endif
+
+// AVX-512 machines take the AVX2 backend : the layers are bound by memory traffic rather than by the vector width
+static const CircleBackend& GetBackend()
+{
+    static const CircleBackend* const backend = []() {
+#if defined(CPU_FEATURES_X86)
+        if (CpuFeatures::GetSimdLevel() != SimdLevel::Scalar)
+        {
+            return &sAvx2Backend;
+        }
+#endif
+        return &sScalarBackend;
+    }();
+    return *backend;
+}
+
+/* CircleFft */
+
+// The top layer takes every power of a primitive 2^logSize-th root w, and each layer below every other one
+CircleFft::CircleFft(const size_t logSize)
+{
+    assert(logSize <= MAX_LOG_SIZE);
+
+    mLogSize = logSize;
+    mSize = (size_t)1 << logSize;
+    mTwiddleReal = new uint32_t[mSize];
+    mTwiddleImaginary = new uint32_t[mSize];
+    mTwiddleReal[0] = 1u;
+    mTwiddleImaginary[0] = 0u;
+
+    const size_t topHalf = mSize >> 1;
+    if (topHalf > 0u)
+    {
+        const Ext<Mpint32, 2> root = Ext<Mpint32, 2>::GetRootOfUnity(logSize);
+        Ext<Mpint32, 2> power((uint64_t)1);
+        for (size_t j = 0; j < topHalf; ++j)
+        {
+            mTwiddleReal[topHalf + j] = power.GetCoefficient(0).GetValue();
+            mTwiddleImaginary[topHalf + j] = power.GetCoefficient(1).GetValue();
+            power *= root;
+        }
+        for (size_t half = topHalf >> 1; half > 0u; half >>= 1)
+        {
+            for (size_t j = 0; j < half; ++j)
+            {
+                mTwiddleReal[half + j] = mTwiddleReal[2u * (half + j)];
+                mTwiddleImaginary[half + j] = mTwiddleImaginary[2u * (half + j)];
+            }
+        }
+    }
+    mSizeInverse = Mpint32((uint64_t)mSize).Invert();
+}
+
+CircleFft::~CircleFft()
+{
+    delete[] mTwiddleReal;
+    delete[] mTwiddleImaginary;
+}
+
+size_t CircleFft::GetSize() const
+{
+    return mSize;
+}
+
+void CircleFft::Forward(Mpint32* real, Mpint32* imaginary) const
+{
+    const CircleBackend& backend = GetBackend();
+    for (size_t half = mSize >> 1; half > 0u; half >>= 1)
+    {
+        backend.forwardLayer((uint32_t*)real, (uint32_t*)imaginary, mTwiddleReal, mTwiddleImaginary, mSize, half);
+    }
+}
+
+void CircleFft::Inverse(Mpint32* real, Mpint32* imaginary) const
+{
+    const CircleBackend& backend = GetBackend();
+    for (size_t half = 1u; half < mSize; half <<= 1)
+    {
+        backend.inverseLayer((uint32_t*)real, (uint32_t*)imaginary, mTwiddleReal, mTwiddleImaginary, mSize, half);
+    }
+    VectorKernel<Mpint32>::Scale(real, real, mSizeInverse, mSize);
+    VectorKernel<Mpint32>::Scale(imaginary, imaginary, mSizeInverse, mSize);
+}
+
+const CircleFft& CircleFft::GetInstance(const size_t logSize)
+{
+    assert(logSize <= MAX_LOG_SIZE);
+
+    thread_local std::unique_ptr<CircleFft> instances[MAX_LOG_SIZE + 1];
+    if (!instances[logSize])
+    {
+        instances[logSize] = std::make_unique<CircleFft>(logSize);
+    }
+    return *instances[logSize];
+}
+
+const char* CircleFft::GetBackendName()
+{
+    return GetBackend().name;
+}
@@ -0,0 +1,43 @@
+#ifndef CIRCLE_FFT_H
+#define CIRCLE_FFT_H
+
+#include <stdint.h>
+
+#include "../math/mpint32.hpp"
+
+/*
+ * Fourier transform of length 2^logSize over the circle group of Z_{2^31 - 1} : the points (x, y) with x^2 + y^2 = 1,
+ * which are the elements x + iy of norm one in Ext<Mpint32, 2> and form a cyclic group of order p + 1 = 2^31.
+ * Values are split into real and imaginary arrays so that butterflies work on whole SIMD registers (circle_fft.cpp).
+ * The inverse of a point is its conjugate (x, -y), so one twiddle table serves both directions.
+ * Forward is decimation in frequency (natural order in, bit-reversed order out) and Inverse is decimation in time
+ * (bit-reversed order in, natural order out, scaled by 1/2^logSize), as in Ntt.
+ * Forward of zero-padded coefficients is the low-degree extension onto the 2^logSize points of the subgroup.
+ */
+class CircleFft
+{
+public:
+    static constexpr size_t MAX_LOG_SIZE = 31;
+
+    CircleFft(const size_t logSize);
+    CircleFft(const CircleFft&) = delete;
+    ~CircleFft();
+
+    size_t GetSize() const;
+    void Forward(Mpint32* real, Mpint32* imaginary) const;
+    void Inverse(Mpint32* real, Mpint32* imaginary) const;
+
+    static const CircleFft& GetInstance(const size_t logSize); // Tables are built once per thread and size
+    static const char* GetBackendName();
+
+    CircleFft& operator=(const CircleFft&) = delete;
+
+private:
+    size_t mLogSize;
+    size_t mSize;
+    uint32_t* mTwiddleReal;      // x of w^j at [h + j] for the layer of half h, with w a primitive 2h-th root of unity
+    uint32_t* mTwiddleImaginary; // y of the same points
+    Mpint32 mSizeInverse;
+};
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef CONSTANT_TABLES_H
+#define CONSTANT_TABLES_H
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <span>
+#include <stdint.h>
+
+#include "../math/extension_field.hpp"
+
+/* Field the tables of Int are computed in : small integers of an extension field lie in its base field */
+template <typename Int> class TableField
+{
+public:
+    using Type = Int;
+};
+
+template <typename Int, size_t K> class TableField<Ext<Int, K>>
+{
+public:
+    using Type = Int;
+};
+
+/*
+ * Whether the nodes Int(0), Int(1), ... add and multiply like the integers, as in the prime fields exposing their
+ * modulus. Otherwise (GF(2^64)) only power sums are tabulated, and Lagrange denominators are computed from the nodes.
+ */
+template <typename Field> concept IntegerNodes = requires { Field::GetBase(); };
+
+/*
+ * Constants of the interpolation nodes 0, 1, ..., MAX_NODE per field type : inverses, factorials and inverse factorials
+ * are generated at compile time, and the power sums S_m(d) = 1^d + 2^d + ... + m^d for 0 <= d <= 2m once on first use
+ * ((MAX_NODE + 1)^2 entries are beyond what constant evaluation handles in reasonable time).
+ * Inverses and factorials exist for IntegerNodes fields only.
+ * Copy functions fall back to computing at run time beyond MAX_NODE.
+ */
+template <typename Int, size_t MAX_NODE = 256> class ConstantTables
+{
+public:
+    static constexpr Int GetInverse(size_t i);          // 1 / i for 1 <= i <= MAX_NODE
+    static constexpr Int GetFactorial(size_t i);        // i! for i <= MAX_NODE
+    static constexpr Int GetInverseFactorial(size_t i); // 1 / i! for i <= MAX_NODE
+
+    // 1 / prod_{j != i} (i - j) over the nodes 0, ..., nNodes - 1, i.e. the Lagrange denominators
+    static void CopyLagrangeDenominatorInverses(Int* dst, const size_t nNodes);
+    // S_m(0), S_m(1), ..., S_m(2m)
+    static void CopyPowerSums(Int* dst, const size_t m);
+
+private:
+    using Field = typename TableField<Int>::Type;
+
+    static constexpr size_t POWER_SUM_SIZE = (MAX_NODE + 1) * (MAX_NODE + 1); // Row m starts at m^2
+
+    static constexpr std::array<Field, MAX_NODE + 1> MakeInverses();
+    static constexpr std::array<Field, MAX_NODE + 1> MakeFactorials();
+    static constexpr std::array<Field, MAX_NODE + 1> MakeInverseFactorials();
+    static const Field* MakePowerSums();
+    static const Field* GetPowerSums();
+    static void CopyFactorialDenominatorInverses(Int* dst, const size_t nNodes);
+    static void CopyNodeDenominatorInverses(Int* dst, const size_t nNodes);
+
+    static constexpr std::array<Field, MAX_NODE + 1> sInverses = MakeInverses();
+    static constexpr std::array<Field, MAX_NODE + 1> sFactorials = MakeFactorials();
+    static constexpr std::array<Field, MAX_NODE + 1> sInverseFactorials = MakeInverseFactorials();
+};
+
+template <typename Int, size_t MAX_NODE> constexpr Int ConstantTables<Int, MAX_NODE>::GetInverse(size_t i)
+{
+    static_assert(IntegerNodes<Field>);
+    assert(1u <= i && i <= MAX_NODE);
+
+    return Int(sInverses[i]);
+}
+
+template <typename Int, size_t MAX_NODE> constexpr Int ConstantTables<Int, MAX_NODE>::GetFactorial(size_t i)
+{
+    static_assert(IntegerNodes<Field>);
+    assert(i <= MAX_NODE);
+
+    return Int(sFactorials[i]);
+}
+
+template <typename Int, size_t MAX_NODE> constexpr Int ConstantTables<Int, MAX_NODE>::GetInverseFactorial(size_t i)
+{
+    static_assert(IntegerNodes<Field>);
+    assert(i <= MAX_NODE);
+
+    return Int(sInverseFactorials[i]);
+}
+
+template <typename Int, size_t MAX_NODE>
+void ConstantTables<Int, MAX_NODE>::CopyLagrangeDenominatorInverses(Int* dst, const size_t nNodes)
+{
+    if (nNodes == 0)
+    {
+        return;
+    }
+
+    if constexpr (IntegerNodes<Field>)
+    {
+        CopyFactorialDenominatorInverses(dst, nNodes);
+    }
+    else
+    {
+        CopyNodeDenominatorInverses(dst, nNodes);
+    }
+}
+
+// prod_{j != i} (i - j) = i! * (n - 1 - i)! * (-1)^(n - 1 - i)
+template <typename Int, size_t MAX_NODE>
+void ConstantTables<Int, MAX_NODE>::CopyFactorialDenominatorInverses(Int* dst, const size_t nNodes)
+{
+    const Field* inverseFactorials = sInverseFactorials.data();
+    Field* computed = (Field*)0;
+    if (nNodes - 1u > MAX_NODE)
+    {
+        // One inversion for the largest factorial, then 1 / (k - 1)! = k / k!
+        computed = new Field[nNodes];
+        Field factorial((uint64_t)1);
+        for (size_t k = 1; k < nNodes; ++k)
+        {
+            factorial *= Field(k);
+        }
+        computed[nNodes - 1u] = factorial.Invert();
+        for (size_t k = nNodes - 1u; k > 0; --k)
+        {
+            computed[k - 1u] = computed[k] * Field(k);
+        }
+        inverseFactorials = computed;
+    }
+
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        const Field inverse = inverseFactorials[i] * inverseFactorials[nNodes - 1u - i];
+        dst[i] = Int((nNodes - 1u - i) % 2u == 0u ? inverse : -inverse);
+    }
+
+    delete[] computed;
+}
+
+// Differences of the nodes multiplied out, then a single batched inversion
+template <typename Int, size_t MAX_NODE>
+void ConstantTables<Int, MAX_NODE>::CopyNodeDenominatorInverses(Int* dst, const size_t nNodes)
+{
+    Field* const denominators = new Field[nNodes];
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        denominators[i] = Field((uint64_t)1);
+        for (size_t j = 0; j < nNodes; ++j)
+        {
+            if (j != i)
+            {
+                denominators[i] *= Field(i) - Field(j);
+            }
+        }
+    }
+    Field::BatchInvert(std::span<Field>(denominators, nNodes));
+
+    for (size_t i = 0; i < nNodes; ++i)
+    {
+        dst[i] = Int(denominators[i]);
+    }
+
+    delete[] denominators;
+}
+
+template <typename Int, size_t MAX_NODE> void ConstantTables<Int, MAX_NODE>::CopyPowerSums(Int* dst, const size_t m)
+{
+    if (m <= MAX_NODE)
+    {
+        const Field* const row = GetPowerSums() + m * m;
+        for (size_t d = 0; d <= 2u * m; ++d)
+        {
+            dst[d] = Int(row[d]);
+        }
+        return;
+    }
+
+    // S_m(0) is summed as well, since m ones do not add up to Int(m) in characteristic 2
+    Field* const powers = new Field[m];
+    for (size_t j = 0; j < m; ++j)
+    {
+        powers[j] = Field((uint64_t)1);
+    }
+    for (size_t d = 0; d <= 2u * m; ++d)
+    {
+        Field sum((uint64_t)0);
+        for (size_t j = 0; j < m; ++j)
+        {
+            sum += powers[j];
+            powers[j] *= Field(j + 1u);
+        }
+        dst[d] = Int(sum);
+    }
+
+    delete[] powers;
+}
+
+// 1 / i = -floor(p / i) / (p mod i) (mod p), and p mod i < i
+template <typename Int, size_t MAX_NODE>
+constexpr std::array<typename TableField<Int>::Type, MAX_NODE + 1> ConstantTables<Int, MAX_NODE>::MakeInverses()
+{
+    const uint64_t base = Field::GetBase();
+    std::array<Field, MAX_NODE + 1> inverses{};
+    if constexpr (MAX_NODE >= 1u)
+    {
+        inverses[1] = Field((uint64_t)1);
+    }
+    for (size_t i = 2; i <= MAX_NODE; ++i)
+    {
+        inverses[i] = -(Field(base / i) * inverses[base % i]);
+    }
+    return inverses;
+}
+
+template <typename Int, size_t MAX_NODE>
+constexpr std::array<typename TableField<Int>::Type, MAX_NODE + 1> ConstantTables<Int, MAX_NODE>::MakeFactorials()
+{
+    std::array<Field, MAX_NODE + 1> factorials{};
+    factorials[0] = Field((uint64_t)1);
+    for (size_t i = 1; i <= MAX_NODE; ++i)
+    {
+        factorials[i] = factorials[i - 1u] * Field(i);
+    }
+    return factorials;
+}
+
+template <typename Int, size_t MAX_NODE>
+constexpr std::array<typename TableField<Int>::Type, MAX_NODE + 1>
+ConstantTables<Int, MAX_NODE>::MakeInverseFactorials()
+{
+    const std::array<Field, MAX_NODE + 1> inverses = MakeInverses();
+    std::array<Field, MAX_NODE + 1> inverseFactorials{};
+    inverseFactorials[0] = Field((uint64_t)1);
+    for (size_t i = 1; i <= MAX_NODE; ++i)
+    {
+        inverseFactorials[i] = inverseFactorials[i - 1u] * inverses[i];
+    }
+    return inverseFactorials;
+}
+
+// S_m(d) = S_{m-1}(d) + m^d, and the two new degrees 2m - 1, 2m are summed from j^(2m - 2) kept per j
+template <typename Int, size_t MAX_NODE>
+const typename TableField<Int>::Type* ConstantTables<Int, MAX_NODE>::MakePowerSums()
+{
+    Field* const powerSums = new Field[POWER_SUM_SIZE];
+    std::array<Field, MAX_NODE + 1> highPowers{}; // j^(2m - 2) for the current row m
+    powerSums[0] = Field((uint64_t)0);
+    for (size_t m = 1; m <= MAX_NODE; ++m)
+    {
+        Field* const row = powerSums + m * m;
+        const Field* const previous = powerSums + (m - 1u) * (m - 1u);
+
+        Field power((uint64_t)1);
+        row[0] = previous[0] + power;
+        for (size_t d = 1; d + 1u < 2u * m; ++d)
+        {
+            power *= Field(m);
+            row[d] = previous[d] + power;
+        }
+
+        highPowers[m] = power;
+        Field oddSum((uint64_t)0);
+        Field evenSum((uint64_t)0);
+        for (size_t j = 1; j <= m; ++j)
+        {
+            if (j < m)
+            {
+                highPowers[j] *= Field(j) * Field(j);
+            }
+            oddSum += highPowers[j] * Field(j);
+            evenSum += highPowers[j] * Field(j) * Field(j);
+        }
+        row[2u * m - 1u] = oddSum;
+        row[2u * m] = evenSum;
+    }
+    return powerSums;
+}
+
+template <typename Int, size_t MAX_NODE>
+const typename TableField<Int>::Type* ConstantTables<Int, MAX_NODE>::GetPowerSums()
+{
+    static const std::unique_ptr<const Field[]> powerSums(MakePowerSums());
+    return powerSums.get();
+}
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef COUNTING_INT_H
+#define COUNTING_INT_H
+
+#include <concepts>
+#include <span>
+#include <stdint.h>
+
+#include "../math/accumulator.hpp"
+#include "../math/constant_tables.hpp"
+#include "../math/ntt.hpp"
+#include "../math/operation_counter.hpp"
+
+/*
+ * Field type counting its operations in OperationCounter, usable as the Int parameter wherever Int is.
+ * Every arithmetic operator counts itself and one reduction, inversions count as one operation,
+ * and accumulators count products and sums but a single reduction per Get().
+ * Conversions, comparisons and constants (ConstantTables) are not counted.
+ */
+template <typename Int> class CountingInt
+{
+public:
+    friend class Accumulator<CountingInt<Int>>;
+
+    constexpr CountingInt();
+    constexpr CountingInt(const Int& value);
+    template <std::integral T> constexpr CountingInt(T value);
+    CountingInt(unsigned char* addr);
+
+    static constexpr auto GetBase();
+    static uint32_t GetSeed();
+    constexpr auto GetValue() const;
+    constexpr const Int& GetInner() const; // Uncounted value
+
+    static constexpr size_t GetTwoAdicity() requires NttField<Int>;
+    static constexpr CountingInt GetRootOfUnity(size_t logOrder) requires NttField<Int>;
+
+    static void SetSeed(uint32_t seed);
+
+    static CountingInt GenerateRandom();
+    static CountingInt GenerateRandomAbove(uint64_t min);
+    static void FillRandom(CountingInt* values, const size_t length);
+    static void Reverse(CountingInt* begin, CountingInt* end);
+    static void BatchInvert(std::span<CountingInt> values);
+    static void Canonicalize(CountingInt* values, const size_t length);
+
+    CountingInt Invert() const;
+    CountingInt Pow(uint64_t exp) const;
+
+    CountingInt operator+(const CountingInt& op) const;
+    CountingInt& operator+=(const CountingInt& op);
+    CountingInt operator-(const CountingInt& op) const;
+    CountingInt& operator-=(const CountingInt& op);
+    CountingInt operator-() const;
+    CountingInt operator*(const CountingInt& op) const;
+    CountingInt& operator*=(const CountingInt& op);
+    CountingInt operator/(const CountingInt& op) const;
+    CountingInt& operator/=(const CountingInt& op);
+    constexpr bool operator==(const CountingInt& op) const;
+    constexpr bool operator!=(const CountingInt& op) const;
+
+private:
+    Int mValue;
+};
+
+/* Products and sums are counted as they are accumulated, and the deferred reduction once in Get() */
+template <typename Int> class Accumulator<CountingInt<Int>>
+{
+public:
+    Accumulator();
+
+    void MultiplyAdd(const CountingInt<Int>& op0, const CountingInt<Int>& op1);
+    void Add(const CountingInt<Int>& op);
+    CountingInt<Int> Get() const;
+
+private:
+    Accumulator<Int> mValue;
+};
+
+// Constants are read from the tables of the counted field
+template <typename Int> class TableField<CountingInt<Int>>
+{
+public:
+    using Type = typename TableField<Int>::Type;
+};
+
+template <typename Int, size_t K> class Lanes;
+
+// Whether Int counts its operations, directly or through a wrapper, which then have to stay on one thread
+template <typename Int> constexpr bool IS_COUNTING_INT = false;
+template <typename Int> constexpr bool IS_COUNTING_INT<CountingInt<Int>> = true;
+template <typename Int, size_t K> constexpr bool IS_COUNTING_INT<Ext<Int, K>> = IS_COUNTING_INT<Int>;
+template <typename Int, size_t K> constexpr bool IS_COUNTING_INT<Lanes<Int, K>> = IS_COUNTING_INT<Int>;
+
+/* Define member functions */
+template <typename Int> constexpr CountingInt<Int>::CountingInt() : mValue()
+{
+}
+
+template <typename Int> constexpr CountingInt<Int>::CountingInt(const Int& value) : mValue(value)
+{
+}
+
+template <typename Int>
+template <std::integral T>
+constexpr CountingInt<Int>::CountingInt(T value) : mValue(value)
+{
+}
+
+template <typename Int> CountingInt<Int>::CountingInt(unsigned char* addr) : mValue(addr)
+{
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+}
+
+template <typename Int> constexpr auto CountingInt<Int>::GetBase()
+{
+    return Int::GetBase();
+}
+
+template <typename Int> uint32_t CountingInt<Int>::GetSeed()
+{
+    return Int::GetSeed();
+}
+
+template <typename Int> constexpr auto CountingInt<Int>::GetValue() const
+{
+    return mValue.GetValue();
+}
+
+template <typename Int> constexpr const Int& CountingInt<Int>::GetInner() const
+{
+    return mValue;
+}
+
+template <typename Int> constexpr size_t CountingInt<Int>::GetTwoAdicity() requires NttField<Int>
+{
+    return Int::GetTwoAdicity();
+}
+
+template <typename Int>
+constexpr CountingInt<Int> CountingInt<Int>::GetRootOfUnity(size_t logOrder) requires NttField<Int>
+{
+    return CountingInt(Int::GetRootOfUnity(logOrder));
+}
+
+template <typename Int> void CountingInt<Int>::SetSeed(uint32_t seed)
+{
+    Int::SetSeed(seed);
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::GenerateRandom()
+{
+    return CountingInt(Int::GenerateRandom());
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::GenerateRandomAbove(uint64_t min)
+{
+    return CountingInt(Int::GenerateRandomAbove(min));
+}
+
+template <typename Int> void CountingInt<Int>::FillRandom(CountingInt* values, const size_t length)
+{
+    Int::FillRandom((Int*)values, length);
+}
+
+template <typename Int> void CountingInt<Int>::Reverse(CountingInt* begin, CountingInt* end)
+{
+    Int::Reverse((Int*)begin, (Int*)end);
+}
+
+// Montgomery's trick as the wrapped field does it : one inversion and 3(n - 1) multiplications
+template <typename Int> void CountingInt<Int>::BatchInvert(std::span<CountingInt> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    OperationCounter::Count(OperationCounter::Operation::Inversion);
+    OperationCounter::Count(OperationCounter::Operation::Multiplication, 3u * (values.size() - 1u));
+    OperationCounter::Count(OperationCounter::Operation::Reduction, 3u * (values.size() - 1u) + 1u);
+    Int::BatchInvert(std::span<Int>((Int*)values.data(), values.size()));
+}
+
+template <typename Int> void CountingInt<Int>::Canonicalize(CountingInt* values, const size_t length)
+{
+    Int::Canonicalize((Int*)values, length);
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::Invert() const
+{
+    OperationCounter::Count(OperationCounter::Operation::Inversion);
+    return CountingInt(mValue.Invert());
+}
+
+// Square and multiply on counted values
+template <typename Int> CountingInt<Int> CountingInt<Int>::Pow(uint64_t exp) const
+{
+    CountingInt result((uint64_t)1);
+    CountingInt base = *this;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result *= base;
+        }
+        exp >>= 1;
+        if (exp > 0)
+        {
+            base *= base;
+        }
+    }
+    return result;
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::operator+(const CountingInt& op) const
+{
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    return CountingInt(mValue + op.mValue);
+}
+
+template <typename Int> CountingInt<Int>& CountingInt<Int>::operator+=(const CountingInt& op)
+{
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    mValue += op.mValue;
+    return *this;
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::operator-(const CountingInt& op) const
+{
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    return CountingInt(mValue - op.mValue);
+}
+
+template <typename Int> CountingInt<Int>& CountingInt<Int>::operator-=(const CountingInt& op)
+{
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    mValue -= op.mValue;
+    return *this;
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::operator-() const
+{
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    return CountingInt(-mValue);
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::operator*(const CountingInt& op) const
+{
+    OperationCounter::Count(OperationCounter::Operation::Multiplication);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    return CountingInt(mValue * op.mValue);
+}
+
+template <typename Int> CountingInt<Int>& CountingInt<Int>::operator*=(const CountingInt& op)
+{
+    OperationCounter::Count(OperationCounter::Operation::Multiplication);
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    mValue *= op.mValue;
+    return *this;
+}
+
+template <typename Int> CountingInt<Int> CountingInt<Int>::operator/(const CountingInt& op) const
+{
+    return (*this) * op.Invert();
+}
+
+template <typename Int> CountingInt<Int>& CountingInt<Int>::operator/=(const CountingInt& op)
+{
+    *this = (*this) * op.Invert();
+    return *this;
+}
+
+template <typename Int> constexpr bool CountingInt<Int>::operator==(const CountingInt& op) const
+{
+    return mValue == op.mValue;
+}
+
+template <typename Int> constexpr bool CountingInt<Int>::operator!=(const CountingInt& op) const
+{
+    return mValue != op.mValue;
+}
+
+template <typename Int> Accumulator<CountingInt<Int>>::Accumulator() : mValue()
+{
+}
+
+template <typename Int>
+void Accumulator<CountingInt<Int>>::MultiplyAdd(const CountingInt<Int>& op0, const CountingInt<Int>& op1)
+{
+    OperationCounter::Count(OperationCounter::Operation::Multiplication);
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    mValue.MultiplyAdd(op0.mValue, op1.mValue);
+}
+
+template <typename Int> void Accumulator<CountingInt<Int>>::Add(const CountingInt<Int>& op)
+{
+    OperationCounter::Count(OperationCounter::Operation::Addition);
+    mValue.Add(op.mValue);
+}
+
+template <typename Int> CountingInt<Int> Accumulator<CountingInt<Int>>::Get() const
+{
+    OperationCounter::Count(OperationCounter::Operation::Reduction);
+    return CountingInt<Int>(mValue.Get());
+}
+
+#endif
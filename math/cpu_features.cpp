@@ -0,0 +1,80 @@
+#include "cpu_features.hpp"
+
+#if defined(CPU_FEATURES_X86) && defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+SimdLevel CpuFeatures::GetSimdLevel()
+{
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+SimdLevel CpuFeatures::DetectSimdLevel()
+{
+#if defined(CPU_FEATURES_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return SimdLevel::Scalar;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx)
+    {
+        return SimdLevel::Scalar;
+    }
+    const unsigned long long xcr0 = _xgetbv(0);
+    if ((xcr0 & 0x6) != 0x6) // OS saves XMM and YMM state
+    {
+        return SimdLevel::Scalar;
+    }
+    __cpuidex(info, 7, 0);
+    if ((info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6) // AVX-512F and OS saves ZMM state
+    {
+        return SimdLevel::Avx512;
+    }
+    if ((info[1] & (1 << 5)) != 0)
+    {
+        return SimdLevel::Avx2;
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::Avx2;
+    }
+#endif
+#endif
+    return SimdLevel::Scalar;
+}
+
+bool CpuFeatures::HasCarrylessMultiply()
+{
+    static const bool hasCarrylessMultiply = DetectCarrylessMultiply();
+    return hasCarrylessMultiply;
+}
+
+bool CpuFeatures::DetectCarrylessMultiply()
+{
+#if defined(CPU_FEATURES_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 1)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("pclmul");
+#endif
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,33 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CPU_FEATURES_X86
+#endif
+
+// Lets a single function use an instruction set beyond the compiler's baseline (MSVC needs no annotation)
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CPU_FEATURES_TARGET(isa)
+#else
+#define CPU_FEATURES_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+enum class SimdLevel
+{
+    Scalar,
+    Avx2,
+    Avx512
+};
+
+class CpuFeatures
+{
+public:
+    static SimdLevel GetSimdLevel();    // Detected once by CPUID, including the OS support for the register state
+    static bool HasCarrylessMultiply(); // PCLMULQDQ, which works on XMM registers only
+
+private:
+    static SimdLevel DetectSimdLevel();
+    static bool DetectCarrylessMultiply();
+};
+
+#endif
@@ -0,0 +1,625 @@
+#ifndef EXTENSION_FIELD_H
+#define EXTENSION_FIELD_H
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <stdint.h>
+
+#include "../math/accumulator.hpp"
+#include "../math/mpint32.hpp"
+#include "../math/mpint64.hpp"
+#include "../math/ntt.hpp"
+
+/* Irreducible modulus of a degree K extension, given as x^K = RESIDUE[0] + RESIDUE[1] * x + ... */
+template <typename Int, size_t K> class ExtensionModulus;
+
+// p = 3 (mod 4) : -1 is not a square, so x^2 + 1 is irreducible
+template <typename Policy> class ExtensionModulus<BasicMpint64<Policy>, 2>
+{
+public:
+    static constexpr int64_t RESIDUE[2] = {-1, 0};
+};
+
+template <typename Policy> class ExtensionModulus<BasicMpint32<Policy>, 2>
+{
+public:
+    static constexpr int64_t RESIDUE[2] = {-1, 0};
+};
+
+// p = 1 (mod 3) and 5 is not a cube mod 2^61 - 1 nor mod 2^31 - 1, so x^3 - 5 is irreducible
+template <typename Policy> class ExtensionModulus<BasicMpint64<Policy>, 3>
+{
+public:
+    static constexpr int64_t RESIDUE[3] = {5, 0, 0};
+};
+
+template <typename Policy> class ExtensionModulus<BasicMpint32<Policy>, 3>
+{
+public:
+    static constexpr int64_t RESIDUE[3] = {5, 0, 0};
+};
+
+// Tower F_p[i][x] / (x^2 - 2 - i) written over F_p : (x^2 - 2)^2 = -1, i.e. x^4 = 4x^2 - 5
+template <typename Policy> class ExtensionModulus<BasicMpint32<Policy>, 4>
+{
+public:
+    static constexpr int64_t RESIDUE[4] = {-5, 0, 4, 0};
+};
+
+/* x^2 + 1 : the Frobenius map negates x, and the elements of norm one form a cyclic group of order p + 1 */
+template <typename Int, size_t K> concept GaussianModulus =
+    K == 2 && ExtensionModulus<Int, K>::RESIDUE[0] == -1 && ExtensionModulus<Int, K>::RESIDUE[1] == 0;
+
+/*
+ * Extension field F_{p^K} = F_p[x] / (modulus) over a base field Int, usable as the Int parameter itself.
+ * Base field values mix in directly, so data can stay in Int while only challenges and queries live in Ext.
+ */
+template <typename Int, size_t K> class Ext
+{
+public:
+    friend class Accumulator<Ext<Int, K>>;
+
+    constexpr Ext();
+    constexpr Ext(const Int& value);
+    template <std::integral T> constexpr Ext(T value);
+    Ext(unsigned char* addr);
+
+    static constexpr size_t GetDegree();
+    static uint32_t GetSeed();
+    constexpr const Int& GetCoefficient(size_t i) const;
+    constexpr bool IsBase() const;
+
+    static void SetSeed(uint32_t seed);
+
+    static Ext GenerateRandom();
+    static Ext GenerateRandomAbove(uint64_t min);
+    static void FillRandom(Ext* values, const size_t length);
+    static void Reverse(Ext* begin, Ext* end);
+    static void BatchInvert(std::span<Ext> values);
+    static void Canonicalize(Ext* values, const size_t length);
+
+    // Roots of unity of order 2^k dividing p + 1, whose conjugates are their inverses (NttField)
+    static constexpr size_t GetTwoAdicity() requires GaussianModulus<Int, K>;
+    static Ext GetRootOfUnity(size_t logOrder) requires GaussianModulus<Int, K>;
+
+    Ext Invert() const;
+    Ext Frobenius() const;
+    Ext Pow(uint64_t exp) const;
+
+    constexpr Ext operator+(const Ext& op) const;
+    constexpr Ext& operator+=(const Ext& op);
+    constexpr Ext operator-(const Ext& op) const;
+    constexpr Ext& operator-=(const Ext& op);
+    constexpr Ext operator-() const;
+    Ext operator*(const Ext& op) const;
+    Ext& operator*=(const Ext& op);
+    Ext operator/(const Ext& op) const;
+    Ext& operator/=(const Ext& op);
+    constexpr bool operator==(const Ext& op) const;
+    constexpr bool operator!=(const Ext& op) const;
+
+    // Mixed base field arithmetic : K base operations instead of a full extension multiplication
+    constexpr Ext operator+(const Int& op) const;
+    constexpr Ext& operator+=(const Int& op);
+    constexpr Ext operator-(const Int& op) const;
+    constexpr Ext& operator-=(const Int& op);
+    constexpr Ext operator*(const Int& op) const;
+    constexpr Ext& operator*=(const Int& op);
+
+private:
+    static constexpr const int64_t* RESIDUE = ExtensionModulus<Int, K>::RESIDUE;
+
+    Int mCoefficients[K];
+
+    static constexpr Int MultiplyByResidue(const Int& value, const int64_t residue);
+    static const std::array<Ext, K>& GetFrobeniusBasis();
+};
+
+template <typename Int, size_t K> constexpr Ext<Int, K> operator*(const Int& op0, const Ext<Int, K>& op1);
+
+/*
+ * Base fields without large power-of-two roots of unity whose quadratic extension has them, as p = 2^61 - 1 with
+ * p + 1 = 2^61 : polynomials over Int are transformed over Ext<Int, 2> instead (Polynomial::MultiplyByQuadraticNtt).
+ */
+template <typename Int> concept QuadraticNttField = GaussianModulus<Int, 2> && NttField<Ext<Int, 2>>;
+
+/* Products are summed per power of x with the base field accumulator, and the modulus is applied once in Get() */
+template <typename Int, size_t K> class Accumulator<Ext<Int, K>>
+{
+public:
+    Accumulator();
+
+    void MultiplyAdd(const Ext<Int, K>& op0, const Ext<Int, K>& op1);
+    void MultiplyAdd(const Ext<Int, K>& op0, const Int& op1);
+    void Add(const Ext<Int, K>& op);
+    Ext<Int, K> Get() const;
+
+private:
+    Accumulator<Int> mTerms[2 * K - 1]; // Coefficients of x^0, ..., x^(2K - 2)
+};
+
+/* Define member functions */
+template <typename Int, size_t K> constexpr Ext<Int, K>::Ext() : mCoefficients()
+{
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K>::Ext(const Int& value) : mCoefficients()
+{
+    mCoefficients[0] = value;
+}
+
+template <typename Int, size_t K>
+template <std::integral T>
+constexpr Ext<Int, K>::Ext(T value) : mCoefficients()
+{
+    mCoefficients[0] = Int(value);
+}
+
+// Reads K consecutive base field elements, as Int(unsigned char*) reads one (e.g. from a hash digest)
+template <typename Int, size_t K> Ext<Int, K>::Ext(unsigned char* addr)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        mCoefficients[i] = Int(addr + i * sizeof(Int));
+    }
+}
+
+template <typename Int, size_t K> constexpr size_t Ext<Int, K>::GetDegree()
+{
+    return K;
+}
+
+template <typename Int, size_t K> uint32_t Ext<Int, K>::GetSeed()
+{
+    return Int::GetSeed();
+}
+
+template <typename Int, size_t K> constexpr const Int& Ext<Int, K>::GetCoefficient(size_t i) const
+{
+    assert(i < K);
+    return mCoefficients[i];
+}
+
+template <typename Int, size_t K> constexpr bool Ext<Int, K>::IsBase() const
+{
+    const Int zero((uint64_t)0);
+    for (size_t i = 1; i < K; ++i)
+    {
+        if (mCoefficients[i] != zero)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Int, size_t K> void Ext<Int, K>::SetSeed(uint32_t seed)
+{
+    Int::SetSeed(seed);
+}
+
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::GenerateRandom()
+{
+    Ext value;
+    FillRandom(&value, 1);
+    return value;
+}
+
+// Outside of {0, ..., min - 1} : only base field values can hit the small integers
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::GenerateRandomAbove(uint64_t min)
+{
+    Ext value;
+    do
+    {
+        FillRandom(&value, 1);
+    } while (value.IsBase() && value.mCoefficients[0] < Int(min));
+    return value;
+}
+
+template <typename Int, size_t K> void Ext<Int, K>::FillRandom(Ext* values, const size_t length)
+{
+    Int::FillRandom((Int*)values, length * K);
+}
+
+template <typename Int, size_t K> void Ext<Int, K>::Reverse(Ext* begin, Ext* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        Ext temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+// Montgomery's trick : one inversion and 3(n - 1) multiplications, zeros are left as they are like Invert()
+template <typename Int, size_t K> void Ext<Int, K>::BatchInvert(std::span<Ext> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    const Ext zero;
+    Ext* const prefixes = new Ext[values.size()];
+    Ext product((uint64_t)1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        prefixes[i] = product;
+        if (values[i] != zero)
+        {
+            product *= values[i];
+        }
+    }
+
+    Ext inverse = product.Invert();
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        if (values[i] != zero)
+        {
+            const Ext value = values[i];
+            values[i] = inverse * prefixes[i];
+            inverse *= value;
+        }
+    }
+
+    delete[] prefixes;
+}
+
+template <typename Int, size_t K> void Ext<Int, K>::Canonicalize(Ext* values, const size_t length)
+{
+    Int::Canonicalize((Int*)values, length * K);
+}
+
+template <typename Int, size_t K>
+constexpr size_t Ext<Int, K>::GetTwoAdicity() requires GaussianModulus<Int, K>
+{
+    size_t twoAdicity = 0u;
+    while (((Int::GetBase() + 1u) >> twoAdicity) % 2u == 0u)
+    {
+        ++twoAdicity;
+    }
+    return twoAdicity;
+}
+
+// z^(p - 1) = conj(z) / z has norm one, and it generates the 2-part of that group for some z = 1 + c x
+template <typename Int, size_t K>
+Ext<Int, K> Ext<Int, K>::GetRootOfUnity(size_t logOrder) requires GaussianModulus<Int, K>
+{
+    assert(logOrder <= GetTwoAdicity());
+
+    const Ext one((uint64_t)1);
+    const uint64_t oddPart = (Int::GetBase() + 1u) >> GetTwoAdicity();
+    Ext root;
+    for (uint64_t c = 1u;; ++c)
+    {
+        Ext z = one;
+        z.mCoefficients[1] = Int(c);
+        root = z.Pow(Int::GetBase() - 1u).Pow(oddPart);
+
+        Ext halfOrderPower = root;
+        for (size_t i = 1; i < GetTwoAdicity(); ++i)
+        {
+            halfOrderPower *= halfOrderPower;
+        }
+        if (halfOrderPower != one)
+        {
+            break;
+        }
+    }
+
+    for (size_t i = logOrder; i < GetTwoAdicity(); ++i)
+    {
+        root *= root;
+    }
+    return root;
+}
+
+// a^-1 = (a^p * ... * a^(p^(K-1))) / N(a), where the norm N(a) = a * a^p * ... * a^(p^(K-1)) is in the base field
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::Invert() const
+{
+    Ext conjugate = Frobenius();
+    Ext conjugates = conjugate;
+    for (size_t i = 2; i < K; ++i)
+    {
+        conjugate = conjugate.Frobenius();
+        conjugates *= conjugate;
+    }
+
+    const Int norm = ((*this) * conjugates).mCoefficients[0];
+    return conjugates * norm.Invert();
+}
+
+// a^p = sum of a_i * (x^p)^i, since a_i^p = a_i
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::Frobenius() const
+{
+    const std::array<Ext, K>& basis = GetFrobeniusBasis();
+
+    Accumulator<Int> terms[K];
+    for (size_t i = 0; i < K; ++i)
+    {
+        for (size_t j = 0; j < K; ++j)
+        {
+            terms[j].MultiplyAdd(mCoefficients[i], basis[i].mCoefficients[j]);
+        }
+    }
+
+    Ext result;
+    for (size_t j = 0; j < K; ++j)
+    {
+        result.mCoefficients[j] = terms[j].Get();
+    }
+    return result;
+}
+
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::Pow(uint64_t exp) const
+{
+    Ext result((uint64_t)1);
+    Ext base = *this;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result *= base;
+        }
+        exp = exp >> 1;
+        base *= base;
+    }
+    return result;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> Ext<Int, K>::operator+(const Ext& op) const
+{
+    Ext result = *this;
+    result += op;
+    return result;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K>& Ext<Int, K>::operator+=(const Ext& op)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        mCoefficients[i] += op.mCoefficients[i];
+    }
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> Ext<Int, K>::operator-(const Ext& op) const
+{
+    Ext result = *this;
+    result -= op;
+    return result;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K>& Ext<Int, K>::operator-=(const Ext& op)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        mCoefficients[i] -= op.mCoefficients[i];
+    }
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> Ext<Int, K>::operator-() const
+{
+    Ext result;
+    for (size_t i = 0; i < K; ++i)
+    {
+        result.mCoefficients[i] = -mCoefficients[i];
+    }
+    return result;
+}
+
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::operator*(const Ext& op) const
+{
+    // (a + bx)(c + dx) = (ac - bd) + ((a + b)(c + d) - ac - bd)x in three products, as in NTT butterflies over Ext
+    if constexpr (GaussianModulus<Int, K>)
+    {
+        const Int ac = mCoefficients[0] * op.mCoefficients[0];
+        const Int bd = mCoefficients[1] * op.mCoefficients[1];
+        const Int sums = (mCoefficients[0] + mCoefficients[1]) * (op.mCoefficients[0] + op.mCoefficients[1]);
+
+        Ext result;
+        result.mCoefficients[0] = ac - bd;
+        result.mCoefficients[1] = sums - ac - bd;
+        return result;
+    }
+
+    Accumulator<Ext> product;
+    product.MultiplyAdd(*this, op);
+    return product.Get();
+}
+
+template <typename Int, size_t K> Ext<Int, K>& Ext<Int, K>::operator*=(const Ext& op)
+{
+    *this = (*this) * op;
+    return *this;
+}
+
+template <typename Int, size_t K> Ext<Int, K> Ext<Int, K>::operator/(const Ext& op) const
+{
+    return (*this) * op.Invert();
+}
+
+template <typename Int, size_t K> Ext<Int, K>& Ext<Int, K>::operator/=(const Ext& op)
+{
+    *this = (*this) * op.Invert();
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr bool Ext<Int, K>::operator==(const Ext& op) const
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        if (mCoefficients[i] != op.mCoefficients[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Int, size_t K> constexpr bool Ext<Int, K>::operator!=(const Ext& op) const
+{
+    return !((*this) == op);
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> Ext<Int, K>::operator+(const Int& op) const
+{
+    Ext result = *this;
+    result.mCoefficients[0] += op;
+    return result;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K>& Ext<Int, K>::operator+=(const Int& op)
+{
+    mCoefficients[0] += op;
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> Ext<Int, K>::operator-(const Int& op) const
+{
+    Ext result = *this;
+    result.mCoefficients[0] -= op;
+    return result;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K>& Ext<Int, K>::operator-=(const Int& op)
+{
+    mCoefficients[0] -= op;
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> Ext<Int, K>::operator*(const Int& op) const
+{
+    Ext result = *this;
+    result *= op;
+    return result;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K>& Ext<Int, K>::operator*=(const Int& op)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        mCoefficients[i] *= op;
+    }
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr Ext<Int, K> operator*(const Int& op0, const Ext<Int, K>& op1)
+{
+    return op1 * op0;
+}
+
+template <typename Int, size_t K>
+constexpr Int Ext<Int, K>::MultiplyByResidue(const Int& value, const int64_t residue)
+{
+    if (residue == 1)
+    {
+        return value;
+    }
+    else if (residue == -1)
+    {
+        return -value;
+    }
+    else if (residue > 0)
+    {
+        return value * Int((uint64_t)residue);
+    }
+    else
+    {
+        return -(value * Int((uint64_t)(-residue)));
+    }
+}
+
+// (x^p)^i for i = 0, ..., K - 1, computed on first use
+template <typename Int, size_t K> const std::array<Ext<Int, K>, K>& Ext<Int, K>::GetFrobeniusBasis()
+{
+    static const std::array<Ext, K> basis = []()
+    {
+        Ext x;
+        x.mCoefficients[1 % K] = Int((uint64_t)1);
+        const Ext xp = x.Pow((uint64_t)Int::GetBase());
+
+        std::array<Ext, K> powers;
+        powers[0] = Ext((uint64_t)1);
+        for (size_t i = 1; i < K; ++i)
+        {
+            powers[i] = powers[i - 1] * xp;
+        }
+        return powers;
+    }();
+    return basis;
+}
+
+/* Accumulator<Ext<Int, K>> */
+
+template <typename Int, size_t K> Accumulator<Ext<Int, K>>::Accumulator()
+{
+}
+
+template <typename Int, size_t K>
+void Accumulator<Ext<Int, K>>::MultiplyAdd(const Ext<Int, K>& op0, const Ext<Int, K>& op1)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        for (size_t j = 0; j < K; ++j)
+        {
+            mTerms[i + j].MultiplyAdd(op0.mCoefficients[i], op1.mCoefficients[j]);
+        }
+    }
+}
+
+template <typename Int, size_t K> void Accumulator<Ext<Int, K>>::MultiplyAdd(const Ext<Int, K>& op0, const Int& op1)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        mTerms[i].MultiplyAdd(op0.mCoefficients[i], op1);
+    }
+}
+
+template <typename Int, size_t K> void Accumulator<Ext<Int, K>>::Add(const Ext<Int, K>& op)
+{
+    for (size_t i = 0; i < K; ++i)
+    {
+        mTerms[i].Add(op.mCoefficients[i]);
+    }
+}
+
+template <typename Int, size_t K> Ext<Int, K> Accumulator<Ext<Int, K>>::Get() const
+{
+    Int terms[2 * K - 1];
+    for (size_t i = 0; i < 2 * K - 1; ++i)
+    {
+        terms[i] = mTerms[i].Get();
+    }
+
+    // x^i = x^(i - K) * (RESIDUE[0] + RESIDUE[1] * x + ...), from the highest power down
+    for (size_t i = 2 * K - 1; i-- > K;)
+    {
+        for (size_t j = 0; j < K; ++j)
+        {
+            if (Ext<Int, K>::RESIDUE[j] != 0)
+            {
+                terms[i - K + j] += Ext<Int, K>::MultiplyByResidue(terms[i], Ext<Int, K>::RESIDUE[j]);
+            }
+        }
+    }
+
+    Ext<Int, K> result;
+    for (size_t i = 0; i < K; ++i)
+    {
+        result.mCoefficients[i] = terms[i];
+    }
+    return result;
+}
+
+#endif
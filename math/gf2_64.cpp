@@ -0,0 +1,84 @@
+#include "gf2_64.hpp"
+#include "cpu_features.hpp"
+
+#if defined(CPU_FEATURES_X86)
+#include <immintrin.h>
+#endif
+
+typedef uint64_t (*WideMultiplier)(uint64_t x, uint64_t y, uint64_t* high);
+
+// Low word of the carry-less product by integer multiplications of every fourth bit : a kept position below 60 sums
+// at most 15 bit products, which fit in the gap of 3 bits above it, and carries from higher ones leave the word
+static uint64_t MultiplyLowScalar(uint64_t x, uint64_t y)
+{
+    const uint64_t m0 = 0x1111111111111111;
+    const uint64_t m1 = m0 << 1;
+    const uint64_t m2 = m0 << 2;
+    const uint64_t m3 = m0 << 3;
+
+    const uint64_t x0 = x & m0;
+    const uint64_t x1 = x & m1;
+    const uint64_t x2 = x & m2;
+    const uint64_t x3 = x & m3;
+    const uint64_t y0 = y & m0;
+    const uint64_t y1 = y & m1;
+    const uint64_t y2 = y & m2;
+    const uint64_t y3 = y & m3;
+
+    const uint64_t z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    const uint64_t z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    const uint64_t z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    const uint64_t z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+    return (z0 & m0) | (z1 & m1) | (z2 & m2) | (z3 & m3);
+}
+
+static uint64_t ReverseBits(uint64_t x)
+{
+    x = ((x >> 1) & 0x5555555555555555) | ((x & 0x5555555555555555) << 1);
+    x = ((x >> 2) & 0x3333333333333333) | ((x & 0x3333333333333333) << 2);
+    x = ((x >> 4) & 0x0F0F0F0F0F0F0F0F) | ((x & 0x0F0F0F0F0F0F0F0F) << 4);
+    x = ((x >> 8) & 0x00FF00FF00FF00FF) | ((x & 0x00FF00FF00FF00FF) << 8);
+    x = ((x >> 16) & 0x0000FFFF0000FFFF) | ((x & 0x0000FFFF0000FFFF) << 16);
+    return (x >> 32) | (x << 32);
+}
+
+// The high word is the low word of the product of the bit-reversed operands, reversed back
+static uint64_t MultiplyWideScalar(uint64_t x, uint64_t y, uint64_t* high)
+{
+    *high = ReverseBits(MultiplyLowScalar(ReverseBits(x), ReverseBits(y))) >> 1;
+    return MultiplyLowScalar(x, y);
+}
+
+#if defined(CPU_FEATURES_X86)
+CPU_FEATURES_TARGET("pclmul") static uint64_t MultiplyWideClmul(uint64_t x, uint64_t y, uint64_t* high)
+{
+    const __m128i product =
+        _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)x), _mm_cvtsi64_si128((long long)y), 0x00);
+    *high = (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product));
+    return (uint64_t)_mm_cvtsi128_si64(product);
+}
+#endif
+
+static WideMultiplier GetWideMultiplier()
+{
+    static const WideMultiplier multiplier = []() {
+#if defined(CPU_FEATURES_X86)
+        if (CpuFeatures::HasCarrylessMultiply())
+        {
+            return &MultiplyWideClmul;
+        }
+#endif
+        return &MultiplyWideScalar;
+    }();
+    return multiplier;
+}
+
+uint64_t GF2_64::MultiplyWide(uint64_t x, uint64_t y, uint64_t& high)
+{
+    return GetWideMultiplier()(x, y, &high);
+}
+
+const char* GF2_64::GetBackendName()
+{
+    return GetWideMultiplier() == &MultiplyWideScalar ? "scalar" : "pclmul";
+}
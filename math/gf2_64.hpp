@@ -0,0 +1,370 @@
+#ifndef GF2_64_H
+#define GF2_64_H
+
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <stdint.h>
+
+#include "../math/accumulator.hpp"
+#include "../math/chacha_prg.hpp"
+#include "../math/packed_codec.hpp"
+
+/*
+ * Binary field GF(2^64) = GF(2)[x] / (x^64 + x^4 + x^3 + x + 1), bit i holding the coefficient of x^i.
+ * Addition and subtraction are both XOR, so additive shares are XOR shares.
+ * Products take the carry-less multiply (PCLMULQDQ) when the CPU has it, chosen once at run time (gf2_64.cpp).
+ * An integer maps to the polynomial of its bits : Int(0), Int(1), ... stay distinct interpolation nodes,
+ * but they do not add or multiply like integers (see IntegerNodes in constant_tables.hpp).
+ */
+class GF2_64
+{
+public:
+    friend class Accumulator<GF2_64>;
+
+    constexpr GF2_64();
+    template <std::integral T> constexpr GF2_64(T value);
+    GF2_64(unsigned char* addr);
+
+    static uint32_t GetSeed();
+    constexpr uint64_t GetValue() const;
+
+    static void SetSeed(uint32_t seed);
+
+    static GF2_64 GenerateRandom();
+    static GF2_64 GenerateRandomAbove(uint64_t min);
+    static void FillRandom(GF2_64* values, const size_t length);
+    static void Reverse(GF2_64* begin, GF2_64* end);
+    static void BatchInvert(std::span<GF2_64> values);
+    static void Canonicalize(GF2_64* values, const size_t length);
+
+    static const char* GetBackendName();
+
+    GF2_64 Invert() const;
+    GF2_64 Pow(uint64_t exp) const;
+
+    constexpr GF2_64 operator+(const GF2_64& op) const;
+    constexpr GF2_64& operator+=(const GF2_64& op);
+    constexpr GF2_64 operator-(const GF2_64& op) const;
+    constexpr GF2_64& operator-=(const GF2_64& op);
+    constexpr GF2_64 operator-() const;
+    GF2_64 operator*(const GF2_64& op) const;
+    GF2_64& operator*=(const GF2_64& op);
+    GF2_64 operator/(const GF2_64& op) const;
+    GF2_64& operator/=(const GF2_64& op);
+    constexpr bool operator==(const GF2_64& op) const;
+    constexpr bool operator!=(const GF2_64& op) const;
+
+private:
+    static uint32_t sSeed; // Random seed
+
+    uint64_t mValue;
+
+    static uint64_t MultiplyWide(uint64_t x, uint64_t y, uint64_t& high); // 128-bit carry-less product
+    static constexpr uint64_t Reduce(uint64_t low, uint64_t high);
+
+    GF2_64 SquareTimes(size_t n) const;
+};
+
+/* Carry-less products add up without carries either, so the reduction is deferred to Get() */
+template <> class Accumulator<GF2_64>
+{
+public:
+    Accumulator();
+
+    void MultiplyAdd(const GF2_64& op0, const GF2_64& op1);
+    void Add(const GF2_64& op);
+    GF2_64 Get() const;
+
+private:
+    uint64_t mLow;
+    uint64_t mHigh;
+};
+
+/* Every 64-bit word is an element */
+template <> class PackedCodec<GF2_64>
+{
+public:
+    static constexpr size_t BITS = 64;
+
+    static constexpr size_t GetPackedBytes(const size_t length);
+    static void Pack(unsigned char* dst, const GF2_64* src, const size_t length);
+    static void Unpack(GF2_64* dst, const unsigned char* src, const size_t length);
+};
+
+/* Initialize static members */
+inline uint32_t GF2_64::sSeed = 0u;
+
+/* Define member functions */
+constexpr GF2_64::GF2_64() : mValue(0u)
+{
+}
+
+template <std::integral T> constexpr GF2_64::GF2_64(T value) : mValue((uint64_t)value)
+{
+}
+
+inline GF2_64::GF2_64(unsigned char* addr)
+{
+    std::memcpy(&mValue, addr, sizeof(uint64_t));
+}
+
+inline uint32_t GF2_64::GetSeed()
+{
+    return sSeed;
+}
+
+constexpr uint64_t GF2_64::GetValue() const
+{
+    return mValue;
+}
+
+inline void GF2_64::SetSeed(uint32_t seed)
+{
+    sSeed = seed;
+    ChaChaPrg::SetGlobalSeed(seed);
+}
+
+inline GF2_64 GF2_64::GenerateRandom()
+{
+    GF2_64 value;
+    FillRandom(&value, 1);
+    return value;
+}
+
+inline GF2_64 GF2_64::GenerateRandomAbove(uint64_t min)
+{
+    GF2_64 value;
+    do
+    {
+        FillRandom(&value, 1);
+    } while (value.mValue < min);
+    return value;
+}
+
+inline void GF2_64::FillRandom(GF2_64* values, const size_t length)
+{
+    ChaChaPrg::GetThreadLocal().Fill((uint64_t*)values, length);
+}
+
+inline void GF2_64::Reverse(GF2_64* begin, GF2_64* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        GF2_64 temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+// Montgomery's trick : one inversion and 3(n - 1) multiplications, zeros are left as they are like Invert()
+inline void GF2_64::BatchInvert(std::span<GF2_64> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    const GF2_64 zero((uint64_t)0);
+    GF2_64* const prefixes = new GF2_64[values.size()];
+    GF2_64 product((uint64_t)1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        prefixes[i] = product;
+        if (values[i] != zero)
+        {
+            product *= values[i];
+        }
+    }
+
+    GF2_64 inverse = product.Invert();
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        if (values[i] != zero)
+        {
+            const GF2_64 value = values[i];
+            values[i] = inverse * prefixes[i];
+            inverse *= value;
+        }
+    }
+
+    delete[] prefixes;
+}
+
+// Values are always canonical
+inline void GF2_64::Canonicalize(GF2_64*, const size_t)
+{
+}
+
+// x^(2^64 - 2) = e(63)^2, where e(k) = x^(2^k - 1) and e(a + b) = e(a)^(2^b) * e(b)
+inline GF2_64 GF2_64::Invert() const
+{
+    const GF2_64 e1 = *this;
+    const GF2_64 e2 = e1.SquareTimes(1) * e1;
+    const GF2_64 e3 = e2.SquareTimes(1) * e1;
+    const GF2_64 e6 = e3.SquareTimes(3) * e3;
+    const GF2_64 e7 = e6.SquareTimes(1) * e1;
+    const GF2_64 e14 = e7.SquareTimes(7) * e7;
+    const GF2_64 e15 = e14.SquareTimes(1) * e1;
+    const GF2_64 e30 = e15.SquareTimes(15) * e15;
+    const GF2_64 e31 = e30.SquareTimes(1) * e1;
+    const GF2_64 e62 = e31.SquareTimes(31) * e31;
+    const GF2_64 e63 = e62.SquareTimes(1) * e1;
+    return e63.SquareTimes(1);
+}
+
+inline GF2_64 GF2_64::Pow(uint64_t exp) const
+{
+    GF2_64 result((uint64_t)1);
+    GF2_64 base = *this;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result *= base;
+        }
+        exp >>= 1;
+        if (exp > 0)
+        {
+            base *= base;
+        }
+    }
+    return result;
+}
+
+constexpr GF2_64 GF2_64::operator+(const GF2_64& op) const
+{
+    GF2_64 result;
+    result.mValue = mValue ^ op.mValue;
+    return result;
+}
+
+constexpr GF2_64& GF2_64::operator+=(const GF2_64& op)
+{
+    mValue ^= op.mValue;
+    return *this;
+}
+
+constexpr GF2_64 GF2_64::operator-(const GF2_64& op) const
+{
+    GF2_64 result;
+    result.mValue = mValue ^ op.mValue;
+    return result;
+}
+
+constexpr GF2_64& GF2_64::operator-=(const GF2_64& op)
+{
+    mValue ^= op.mValue;
+    return *this;
+}
+
+constexpr GF2_64 GF2_64::operator-() const
+{
+    return *this;
+}
+
+inline GF2_64 GF2_64::operator*(const GF2_64& op) const
+{
+    uint64_t high;
+    const uint64_t low = MultiplyWide(mValue, op.mValue, high);
+    GF2_64 result;
+    result.mValue = Reduce(low, high);
+    return result;
+}
+
+inline GF2_64& GF2_64::operator*=(const GF2_64& op)
+{
+    uint64_t high;
+    const uint64_t low = MultiplyWide(mValue, op.mValue, high);
+    mValue = Reduce(low, high);
+    return *this;
+}
+
+inline GF2_64 GF2_64::operator/(const GF2_64& op) const
+{
+    return (*this) * op.Invert();
+}
+
+inline GF2_64& GF2_64::operator/=(const GF2_64& op)
+{
+    *this = (*this) * op.Invert();
+    return *this;
+}
+
+constexpr bool GF2_64::operator==(const GF2_64& op) const
+{
+    return mValue == op.mValue;
+}
+
+constexpr bool GF2_64::operator!=(const GF2_64& op) const
+{
+    return mValue != op.mValue;
+}
+
+// x^64 = x^4 + x^3 + x + 1 : the high word is folded in once, and its top 4 bits shifted out are folded in again
+constexpr uint64_t GF2_64::Reduce(uint64_t low, uint64_t high)
+{
+    const uint64_t folded = high ^ (high >> 63) ^ (high >> 61) ^ (high >> 60);
+    return low ^ folded ^ (folded << 1) ^ (folded << 3) ^ (folded << 4);
+}
+
+inline GF2_64 GF2_64::SquareTimes(size_t n) const
+{
+    GF2_64 result = *this;
+    for (size_t i = 0; i < n; ++i)
+    {
+        result *= result;
+    }
+    return result;
+}
+
+/* Accumulator<GF2_64> */
+
+inline Accumulator<GF2_64>::Accumulator() : mLow(0u), mHigh(0u)
+{
+}
+
+inline void Accumulator<GF2_64>::MultiplyAdd(const GF2_64& op0, const GF2_64& op1)
+{
+    uint64_t high;
+    mLow ^= GF2_64::MultiplyWide(op0.mValue, op1.mValue, high);
+    mHigh ^= high;
+}
+
+inline void Accumulator<GF2_64>::Add(const GF2_64& op)
+{
+    mLow ^= op.mValue;
+}
+
+inline GF2_64 Accumulator<GF2_64>::Get() const
+{
+    GF2_64 result;
+    result.mValue = GF2_64::Reduce(mLow, mHigh);
+    return result;
+}
+
+/* PackedCodec<GF2_64> */
+
+constexpr size_t PackedCodec<GF2_64>::GetPackedBytes(const size_t length)
+{
+    return length * sizeof(uint64_t);
+}
+
+inline void PackedCodec<GF2_64>::Pack(unsigned char* dst, const GF2_64* src, const size_t length)
+{
+    std::memcpy(dst, src, length * sizeof(uint64_t));
+}
+
+inline void PackedCodec<GF2_64>::Unpack(GF2_64* dst, const unsigned char* src, const size_t length)
+{
+    std::memcpy(dst, src, length * sizeof(uint64_t));
+}
+
+#endif
@@ -0,0 +1,548 @@
+#ifndef LANES_H
+#define LANES_H
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <stdint.h>
+
+#include "../math/accumulator.hpp"
+#include "../math/constant_tables.hpp"
+#include "../math/cpu_features.hpp"
+#include "../math/mpint32.hpp"
+#include "../math/packed_codec.hpp"
+#include "../math/vector_kernel.hpp"
+
+#if defined(CPU_FEATURES_X86)
+#include <emmintrin.h>
+#endif
+
+/*
+ * K independent repetitions of a protocol over Int run side by side : F_p^K with lane-wise arithmetic.
+ * Used as the Int parameter, every pass over the data computes all K repetitions at once, each lane drawing its own
+ * challenges, and two values are equal only when all their lanes are.
+ * Lanes are stored contiguously, so an array of n values is an array of n * K base field values.
+ */
+template <typename Int, size_t K> class Lanes
+{
+public:
+    friend class Accumulator<Lanes<Int, K>>;
+
+    constexpr Lanes();
+    constexpr Lanes(const Int& value); // Same value in every lane
+    template <std::integral T> constexpr Lanes(T value);
+    Lanes(unsigned char* addr); // A digest gives every lane its own value
+
+    static constexpr size_t GetWidth();
+    static uint32_t GetSeed();
+    constexpr const Int& GetLane(size_t k) const;
+
+    static void SetSeed(uint32_t seed);
+
+    static Lanes GenerateRandom();
+    static Lanes GenerateRandomAbove(uint64_t min);
+    static void FillRandom(Lanes* values, const size_t length);
+    static void Reverse(Lanes* begin, Lanes* end);
+    static void BatchInvert(std::span<Lanes> values);
+    static void Canonicalize(Lanes* values, const size_t length);
+
+    Lanes Invert() const;
+    Lanes Pow(uint64_t exp) const;
+
+    Lanes operator+(const Lanes& op) const;
+    Lanes& operator+=(const Lanes& op);
+    Lanes operator-(const Lanes& op) const;
+    Lanes& operator-=(const Lanes& op);
+    Lanes operator-() const;
+    Lanes operator*(const Lanes& op) const;
+    Lanes& operator*=(const Lanes& op);
+    Lanes operator/(const Lanes& op) const;
+    Lanes& operator/=(const Lanes& op);
+    constexpr bool operator==(const Lanes& op) const;
+    constexpr bool operator!=(const Lanes& op) const;
+
+private:
+    static constexpr size_t DIGEST_BYTES = 64; // SHA-512
+
+    Int mLanes[K];
+};
+
+/* Arithmetic on the K lanes of a value at once (dst may alias an operand) */
+template <typename Int, size_t K> class LaneArithmetic
+{
+public:
+    static void Add(Int* dst, const Int* op0, const Int* op1);
+    static void Sub(Int* dst, const Int* op0, const Int* op1);
+    static void Mul(Int* dst, const Int* op0, const Int* op1);
+};
+
+#if defined(CPU_FEATURES_X86)
+/*
+ * Mpint32 lanes go four to an SSE2 register, which every x86-64 target has, so the operators stay inline in the
+ * protocol loops instead of calling into the VectorKernel backends value by value.
+ */
+template <size_t K> class LaneArithmetic<Mpint32, K>
+{
+public:
+    static void Add(Mpint32* dst, const Mpint32* op0, const Mpint32* op1);
+    static void Sub(Mpint32* dst, const Mpint32* op0, const Mpint32* op1);
+    static void Mul(Mpint32* dst, const Mpint32* op0, const Mpint32* op1);
+
+private:
+    static constexpr size_t WIDTH = 4; // Lanes per register
+    static constexpr uint32_t BASE = 0x7FFFFFFF;
+
+    static __m128i Canonicalize(__m128i x);
+};
+#endif
+
+/* Each lane defers its reduction in its own base field accumulator */
+template <typename Int, size_t K> class Accumulator<Lanes<Int, K>>
+{
+public:
+    Accumulator();
+
+    void MultiplyAdd(const Lanes<Int, K>& op0, const Lanes<Int, K>& op1);
+    void Add(const Lanes<Int, K>& op);
+    Lanes<Int, K> Get() const;
+
+private:
+    Accumulator<Int> mLanes[K];
+};
+
+/* Element-wise kernels run on the n * K base field values, so Mersenne lanes use the SIMD backends */
+template <typename Int, size_t K> class VectorKernel<Lanes<Int, K>>
+{
+public:
+    static void Add(Lanes<Int, K>* dst, const Lanes<Int, K>* op0, const Lanes<Int, K>* op1, const size_t length);
+    static void Sub(Lanes<Int, K>* dst, const Lanes<Int, K>* op0, const Lanes<Int, K>* op1, const size_t length);
+    static void Mul(Lanes<Int, K>* dst, const Lanes<Int, K>* op0, const Lanes<Int, K>* op1, const size_t length);
+    static void Scale(Lanes<Int, K>* dst, const Lanes<Int, K>* op, const Lanes<Int, K> scalar, const size_t length);
+    static void Axpy(Lanes<Int, K>* dst, const Lanes<Int, K> scalar, const Lanes<Int, K>* op, const size_t length);
+    static Lanes<Int, K> Dot(const Lanes<Int, K>* op0, const Lanes<Int, K>* op1, const size_t length);
+
+private:
+    static constexpr size_t CHUNK = 64; // Values per pass of Scale and Axpy, with the scalar repeated over a chunk
+};
+
+/* Lanes are packed as their K base field values */
+template <typename Int, size_t K> class PackedCodec<Lanes<Int, K>>
+{
+public:
+    static constexpr size_t BITS = K * PackedCodec<Int>::BITS;
+
+    static constexpr size_t GetPackedBytes(const size_t length);
+    static void Pack(unsigned char* dst, const Lanes<Int, K>* src, const size_t length);
+    static void Unpack(Lanes<Int, K>* dst, const unsigned char* src, const size_t length);
+};
+
+// Constants are the same in every lane
+template <typename Int, size_t K> class TableField<Lanes<Int, K>>
+{
+public:
+    using Type = typename TableField<Int>::Type;
+};
+
+/* Define member functions */
+template <typename Int, size_t K> constexpr Lanes<Int, K>::Lanes() : mLanes()
+{
+}
+
+template <typename Int, size_t K> constexpr Lanes<Int, K>::Lanes(const Int& value) : mLanes()
+{
+    for (size_t k = 0; k < K; ++k)
+    {
+        mLanes[k] = value;
+    }
+}
+
+template <typename Int, size_t K>
+template <std::integral T>
+constexpr Lanes<Int, K>::Lanes(T value) : Lanes(Int(value))
+{
+}
+
+// Lanes read disjoint words of the digest
+template <typename Int, size_t K> Lanes<Int, K>::Lanes(unsigned char* addr)
+{
+    static_assert(K * sizeof(Int) <= DIGEST_BYTES);
+
+    for (size_t k = 0; k < K; ++k)
+    {
+        mLanes[k] = Int(addr + k * sizeof(Int));
+    }
+}
+
+template <typename Int, size_t K> constexpr size_t Lanes<Int, K>::GetWidth()
+{
+    return K;
+}
+
+template <typename Int, size_t K> uint32_t Lanes<Int, K>::GetSeed()
+{
+    return Int::GetSeed();
+}
+
+template <typename Int, size_t K> constexpr const Int& Lanes<Int, K>::GetLane(size_t k) const
+{
+    assert(k < K);
+
+    return mLanes[k];
+}
+
+template <typename Int, size_t K> void Lanes<Int, K>::SetSeed(uint32_t seed)
+{
+    Int::SetSeed(seed);
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::GenerateRandom()
+{
+    Lanes value;
+    Int::FillRandom(value.mLanes, K);
+    return value;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::GenerateRandomAbove(uint64_t min)
+{
+    Lanes value;
+    for (size_t k = 0; k < K; ++k)
+    {
+        value.mLanes[k] = Int::GenerateRandomAbove(min);
+    }
+    return value;
+}
+
+template <typename Int, size_t K> void Lanes<Int, K>::FillRandom(Lanes* values, const size_t length)
+{
+    Int::FillRandom((Int*)values, length * K);
+}
+
+template <typename Int, size_t K> void Lanes<Int, K>::Reverse(Lanes* begin, Lanes* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        Lanes temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+// Lane-wise inversion is inversion of every base field value, so a single Montgomery's trick covers all lanes
+template <typename Int, size_t K> void Lanes<Int, K>::BatchInvert(std::span<Lanes> values)
+{
+    Int::BatchInvert(std::span<Int>((Int*)values.data(), values.size() * K));
+}
+
+template <typename Int, size_t K> void Lanes<Int, K>::Canonicalize(Lanes* values, const size_t length)
+{
+    Int::Canonicalize((Int*)values, length * K);
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::Invert() const
+{
+    Lanes result = *this;
+    Int::BatchInvert(std::span<Int>(result.mLanes, K));
+    return result;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::Pow(uint64_t exp) const
+{
+    Lanes result;
+    for (size_t k = 0; k < K; ++k)
+    {
+        result.mLanes[k] = mLanes[k].Pow(exp);
+    }
+    return result;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::operator+(const Lanes& op) const
+{
+    Lanes result;
+    LaneArithmetic<Int, K>::Add(result.mLanes, mLanes, op.mLanes);
+    return result;
+}
+
+template <typename Int, size_t K> Lanes<Int, K>& Lanes<Int, K>::operator+=(const Lanes& op)
+{
+    LaneArithmetic<Int, K>::Add(mLanes, mLanes, op.mLanes);
+    return *this;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::operator-(const Lanes& op) const
+{
+    Lanes result;
+    LaneArithmetic<Int, K>::Sub(result.mLanes, mLanes, op.mLanes);
+    return result;
+}
+
+template <typename Int, size_t K> Lanes<Int, K>& Lanes<Int, K>::operator-=(const Lanes& op)
+{
+    LaneArithmetic<Int, K>::Sub(mLanes, mLanes, op.mLanes);
+    return *this;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::operator-() const
+{
+    Lanes result;
+    LaneArithmetic<Int, K>::Sub(result.mLanes, result.mLanes, mLanes);
+    return result;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::operator*(const Lanes& op) const
+{
+    Lanes result;
+    LaneArithmetic<Int, K>::Mul(result.mLanes, mLanes, op.mLanes);
+    return result;
+}
+
+template <typename Int, size_t K> Lanes<Int, K>& Lanes<Int, K>::operator*=(const Lanes& op)
+{
+    LaneArithmetic<Int, K>::Mul(mLanes, mLanes, op.mLanes);
+    return *this;
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Lanes<Int, K>::operator/(const Lanes& op) const
+{
+    return (*this) * op.Invert();
+}
+
+template <typename Int, size_t K> Lanes<Int, K>& Lanes<Int, K>::operator/=(const Lanes& op)
+{
+    *this = (*this) * op.Invert();
+    return *this;
+}
+
+template <typename Int, size_t K> constexpr bool Lanes<Int, K>::operator==(const Lanes& op) const
+{
+    bool isEqual = true;
+    for (size_t k = 0; k < K; ++k)
+    {
+        isEqual = isEqual && mLanes[k] == op.mLanes[k];
+    }
+    return isEqual;
+}
+
+template <typename Int, size_t K> constexpr bool Lanes<Int, K>::operator!=(const Lanes& op) const
+{
+    return !(*this == op);
+}
+
+/* LaneArithmetic */
+
+template <typename Int, size_t K> void LaneArithmetic<Int, K>::Add(Int* dst, const Int* op0, const Int* op1)
+{
+    for (size_t k = 0; k < K; ++k)
+    {
+        dst[k] = op0[k] + op1[k];
+    }
+}
+
+template <typename Int, size_t K> void LaneArithmetic<Int, K>::Sub(Int* dst, const Int* op0, const Int* op1)
+{
+    for (size_t k = 0; k < K; ++k)
+    {
+        dst[k] = op0[k] - op1[k];
+    }
+}
+
+template <typename Int, size_t K> void LaneArithmetic<Int, K>::Mul(Int* dst, const Int* op0, const Int* op1)
+{
+    for (size_t k = 0; k < K; ++k)
+    {
+        dst[k] = op0[k] * op1[k];
+    }
+}
+
+#if defined(CPU_FEATURES_X86)
+template <size_t K> void LaneArithmetic<Mpint32, K>::Add(Mpint32* dst, const Mpint32* op0, const Mpint32* op1)
+{
+    size_t k = 0;
+    for (; k + WIDTH <= K; k += WIDTH)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(op0 + k));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(op1 + k));
+        _mm_storeu_si128((__m128i*)(dst + k), Canonicalize(_mm_add_epi32(x, y)));
+    }
+    for (; k < K; ++k)
+    {
+        dst[k] = op0[k] + op1[k];
+    }
+}
+
+template <size_t K> void LaneArithmetic<Mpint32, K>::Sub(Mpint32* dst, const Mpint32* op0, const Mpint32* op1)
+{
+    const __m128i p = _mm_set1_epi32(BASE);
+    size_t k = 0;
+    for (; k + WIDTH <= K; k += WIDTH)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(op0 + k));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(op1 + k));
+        const __m128i diff = _mm_sub_epi32(x, y); // In (-p, p), so the sign bit tells whether to add p back
+        _mm_storeu_si128((__m128i*)(dst + k), _mm_add_epi32(diff, _mm_and_si128(_mm_srai_epi32(diff, 31), p)));
+    }
+    for (; k < K; ++k)
+    {
+        dst[k] = op0[k] - op1[k];
+    }
+}
+
+// Products of the even and odd lanes are folded to below 2p in their 64-bit halves, then merged and made canonical
+template <size_t K> void LaneArithmetic<Mpint32, K>::Mul(Mpint32* dst, const Mpint32* op0, const Mpint32* op1)
+{
+    const __m128i p = _mm_set1_epi64x(BASE);
+    size_t k = 0;
+    for (; k + WIDTH <= K; k += WIDTH)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(op0 + k));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(op1 + k));
+        const __m128i productEven = _mm_mul_epu32(x, y);
+        const __m128i productOdd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+        const __m128i even = _mm_add_epi64(_mm_and_si128(productEven, p), _mm_srli_epi64(productEven, 31));
+        const __m128i odd = _mm_add_epi64(_mm_and_si128(productOdd, p), _mm_srli_epi64(productOdd, 31));
+        _mm_storeu_si128((__m128i*)(dst + k), Canonicalize(_mm_or_si128(even, _mm_slli_epi64(odd, 32))));
+    }
+    for (; k < K; ++k)
+    {
+        dst[k] = op0[k] * op1[k];
+    }
+}
+
+// For x < 2p, x - p is negative as a signed lane exactly when x < p
+template <size_t K> __m128i LaneArithmetic<Mpint32, K>::Canonicalize(__m128i x)
+{
+    const __m128i p = _mm_set1_epi32(BASE);
+    const __m128i diff = _mm_sub_epi32(x, p);
+    return _mm_add_epi32(diff, _mm_and_si128(_mm_srai_epi32(diff, 31), p));
+}
+#endif
+
+/* Accumulator<Lanes> */
+
+template <typename Int, size_t K> Accumulator<Lanes<Int, K>>::Accumulator() : mLanes()
+{
+}
+
+template <typename Int, size_t K>
+void Accumulator<Lanes<Int, K>>::MultiplyAdd(const Lanes<Int, K>& op0, const Lanes<Int, K>& op1)
+{
+    for (size_t k = 0; k < K; ++k)
+    {
+        mLanes[k].MultiplyAdd(op0.mLanes[k], op1.mLanes[k]);
+    }
+}
+
+template <typename Int, size_t K> void Accumulator<Lanes<Int, K>>::Add(const Lanes<Int, K>& op)
+{
+    for (size_t k = 0; k < K; ++k)
+    {
+        mLanes[k].Add(op.mLanes[k]);
+    }
+}
+
+template <typename Int, size_t K> Lanes<Int, K> Accumulator<Lanes<Int, K>>::Get() const
+{
+    Lanes<Int, K> result;
+    for (size_t k = 0; k < K; ++k)
+    {
+        result.mLanes[k] = mLanes[k].Get();
+    }
+    return result;
+}
+
+/* VectorKernel<Lanes> */
+
+template <typename Int, size_t K>
+void VectorKernel<Lanes<Int, K>>::Add(Lanes<Int, K>* dst, const Lanes<Int, K>* op0, const Lanes<Int, K>* op1,
+                                      const size_t length)
+{
+    VectorKernel<Int>::Add((Int*)dst, (const Int*)op0, (const Int*)op1, length * K);
+}
+
+template <typename Int, size_t K>
+void VectorKernel<Lanes<Int, K>>::Sub(Lanes<Int, K>* dst, const Lanes<Int, K>* op0, const Lanes<Int, K>* op1,
+                                      const size_t length)
+{
+    VectorKernel<Int>::Sub((Int*)dst, (const Int*)op0, (const Int*)op1, length * K);
+}
+
+template <typename Int, size_t K>
+void VectorKernel<Lanes<Int, K>>::Mul(Lanes<Int, K>* dst, const Lanes<Int, K>* op0, const Lanes<Int, K>* op1,
+                                      const size_t length)
+{
+    VectorKernel<Int>::Mul((Int*)dst, (const Int*)op0, (const Int*)op1, length * K);
+}
+
+template <typename Int, size_t K>
+void VectorKernel<Lanes<Int, K>>::Scale(Lanes<Int, K>* dst, const Lanes<Int, K>* op, const Lanes<Int, K> scalar,
+                                        const size_t length)
+{
+    Lanes<Int, K> scalars[CHUNK];
+    for (size_t i = 0; i < CHUNK; ++i)
+    {
+        scalars[i] = scalar;
+    }
+    for (size_t i = 0; i < length; i += CHUNK)
+    {
+        const size_t chunk = std::min(CHUNK, length - i);
+        VectorKernel<Int>::Mul((Int*)(dst + i), (const Int*)(op + i), (const Int*)scalars, chunk * K);
+    }
+}
+
+template <typename Int, size_t K>
+void VectorKernel<Lanes<Int, K>>::Axpy(Lanes<Int, K>* dst, const Lanes<Int, K> scalar, const Lanes<Int, K>* op,
+                                       const size_t length)
+{
+    Lanes<Int, K> scalars[CHUNK];
+    Lanes<Int, K> products[CHUNK];
+    for (size_t i = 0; i < CHUNK; ++i)
+    {
+        scalars[i] = scalar;
+    }
+    for (size_t i = 0; i < length; i += CHUNK)
+    {
+        const size_t chunk = std::min(CHUNK, length - i);
+        VectorKernel<Int>::Mul((Int*)products, (const Int*)(op + i), (const Int*)scalars, chunk * K);
+        VectorKernel<Int>::Add((Int*)(dst + i), (const Int*)(dst + i), (const Int*)products, chunk * K);
+    }
+}
+
+template <typename Int, size_t K>
+Lanes<Int, K> VectorKernel<Lanes<Int, K>>::Dot(const Lanes<Int, K>* op0, const Lanes<Int, K>* op1,
+                                               const size_t length)
+{
+    Accumulator<Lanes<Int, K>> result;
+    for (size_t i = 0; i < length; ++i)
+    {
+        result.MultiplyAdd(op0[i], op1[i]);
+    }
+    return result.Get();
+}
+
+/* PackedCodec<Lanes> */
+
+template <typename Int, size_t K> constexpr size_t PackedCodec<Lanes<Int, K>>::GetPackedBytes(const size_t length)
+{
+    return PackedCodec<Int>::GetPackedBytes(length * K);
+}
+
+template <typename Int, size_t K>
+void PackedCodec<Lanes<Int, K>>::Pack(unsigned char* dst, const Lanes<Int, K>* src, const size_t length)
+{
+    PackedCodec<Int>::Pack(dst, (const Int*)src, length * K);
+}
+
+template <typename Int, size_t K>
+void PackedCodec<Lanes<Int, K>>::Unpack(Lanes<Int, K>* dst, const unsigned char* src, const size_t length)
+{
+    PackedCodec<Int>::Unpack((Int*)dst, src, length * K);
+}
+
+#endif
@@ -0,0 +1,455 @@
+#ifndef MPINT128_H
+#define MPINT128_H
+
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <stdint.h>
+
+#include "../math/chacha_prg.hpp"
+#include "../math/packed_codec.hpp"
+
+/*
+ * 128-bit Integer over Mersenne Prime Field : Z_{2^127 - 1}, kept canonical in two 64-bit limbs.
+ * Products take four 64 x 64 -> 128-bit multiplications and are folded with 2^127 = 1 (mod p).
+ * A single challenge has about the soundness of two repetitions over Z_{2^61 - 1}.
+ * The modulus does not fit the 64-bit GetBase() of the other fields, so Mpint128 is not IntegerNodes
+ * (constant_tables.hpp) and its Lagrange denominators and power sums are computed from the nodes.
+ */
+class Mpint128
+{
+public:
+    constexpr Mpint128();
+    template <std::integral T> constexpr Mpint128(T value);
+    Mpint128(unsigned char* addr);
+
+    static uint32_t GetSeed();
+    constexpr uint64_t GetValue() const;     // Low 64 bits of the canonical value
+    constexpr uint64_t GetHighValue() const; // Bits 64 to 126 of the canonical value
+
+    static void SetSeed(uint32_t seed);
+
+    static Mpint128 GenerateRandom();
+    static Mpint128 GenerateRandomAbove(uint64_t min);
+    static void FillRandom(Mpint128* values, const size_t length);
+    static void Reverse(Mpint128* begin, Mpint128* end);
+    static void BatchInvert(std::span<Mpint128> values);
+    static void Canonicalize(Mpint128* values, const size_t length);
+
+    constexpr Mpint128 Invert() const;
+    constexpr Mpint128 Pow(uint64_t exp) const;
+
+    constexpr Mpint128 operator+(const Mpint128& op) const;
+    constexpr Mpint128& operator+=(const Mpint128& op);
+    constexpr Mpint128 operator-(const Mpint128& op) const;
+    constexpr Mpint128& operator-=(const Mpint128& op);
+    constexpr Mpint128 operator-() const;
+    constexpr Mpint128 operator*(const Mpint128& op) const;
+    constexpr Mpint128& operator*=(const Mpint128& op);
+    constexpr Mpint128 operator/(const Mpint128& op) const;
+    constexpr Mpint128& operator/=(const Mpint128& op);
+    constexpr bool operator==(const Mpint128& op) const;
+    constexpr bool operator!=(const Mpint128& op) const;
+
+private:
+    static constexpr uint64_t HIGH_MASK = 0x7FFFFFFFFFFFFFFF; // High limb of 2^127 - 1 (Mersenne prime)
+    static uint32_t sSeed;                                    // Random seed
+
+    uint64_t mLow;
+    uint64_t mHigh;
+
+    static constexpr uint64_t MultiplyWide(uint64_t x, uint64_t y, uint64_t& high);
+    static constexpr void Reduce(uint64_t& low, uint64_t& high);
+    static constexpr Mpint128 Fold(uint64_t r0, uint64_t r1, uint64_t r2, uint64_t r3);
+
+    constexpr bool IsBase() const;
+    constexpr Mpint128 Square() const;
+    constexpr Mpint128 SquareTimes(size_t n) const;
+};
+
+/* Low words of all elements, then the remaining 63 bits of every element back to back (BitPacking) */
+template <> class PackedCodec<Mpint128>
+{
+public:
+    static constexpr size_t BITS = 127;
+
+    static constexpr size_t GetPackedBytes(const size_t length);
+    static void Pack(unsigned char* dst, const Mpint128* src, const size_t length);
+    static void Unpack(Mpint128* dst, const unsigned char* src, const size_t length);
+};
+
+/* Initialize static members */
+inline uint32_t Mpint128::sSeed = 0u;
+
+/* Define member functions */
+constexpr Mpint128::Mpint128() : mLow(0u), mHigh(0u)
+{
+}
+
+template <std::integral T> constexpr Mpint128::Mpint128(T value) : mLow((uint64_t)value), mHigh(0u)
+{
+}
+
+inline Mpint128::Mpint128(unsigned char* addr)
+{
+    std::memcpy(&mLow, addr, sizeof(uint64_t));
+    std::memcpy(&mHigh, addr + sizeof(uint64_t), sizeof(uint64_t));
+    mHigh &= HIGH_MASK;
+    Reduce(mLow, mHigh);
+}
+
+inline uint32_t Mpint128::GetSeed()
+{
+    return sSeed;
+}
+
+constexpr uint64_t Mpint128::GetValue() const
+{
+    return mLow;
+}
+
+constexpr uint64_t Mpint128::GetHighValue() const
+{
+    return mHigh;
+}
+
+inline void Mpint128::SetSeed(uint32_t seed)
+{
+    sSeed = seed;
+    ChaChaPrg::SetGlobalSeed(seed);
+}
+
+inline Mpint128 Mpint128::GenerateRandom()
+{
+    Mpint128 value;
+    FillRandom(&value, 1);
+    return value;
+}
+
+inline Mpint128 Mpint128::GenerateRandomAbove(uint64_t min)
+{
+    Mpint128 value;
+    do
+    {
+        FillRandom(&value, 1);
+    } while (value.mHigh == 0u && value.mLow < min);
+    return value;
+}
+
+// Uniform over [0, p) : masked words are all in range except p itself, which is redrawn
+inline void Mpint128::FillRandom(Mpint128* values, const size_t length)
+{
+    ChaChaPrg& prg = ChaChaPrg::GetThreadLocal();
+    prg.Fill((uint64_t*)values, 2u * length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        values[i].mHigh &= HIGH_MASK;
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+        while (values[i].IsBase())
+        {
+            values[i].mLow = (uint64_t)prg.Next64();
+            values[i].mHigh = (uint64_t)prg.Next64() & HIGH_MASK;
+        }
+    }
+}
+
+inline void Mpint128::Reverse(Mpint128* begin, Mpint128* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        Mpint128 temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+// Montgomery's trick : one inversion and 3(n - 1) multiplications, zeros are left as they are like Invert()
+inline void Mpint128::BatchInvert(std::span<Mpint128> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    const Mpint128 zero((uint64_t)0);
+    Mpint128* const prefixes = new Mpint128[values.size()];
+    Mpint128 product((uint64_t)1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        prefixes[i] = product;
+        if (values[i] != zero)
+        {
+            product *= values[i];
+        }
+    }
+
+    Mpint128 inverse = product.Invert();
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        if (values[i] != zero)
+        {
+            const Mpint128 value = values[i];
+            values[i] = inverse * prefixes[i];
+            inverse *= value;
+        }
+    }
+
+    delete[] prefixes;
+}
+
+// Values are always canonical
+inline void Mpint128::Canonicalize(Mpint128*, const size_t)
+{
+}
+
+// p - 2 = 2^127 - 3 = (2^125 - 1) * 2^2 + 1, where e(k) = x^(2^k - 1) and e(a + b) = e(a)^(2^b) * e(b)
+constexpr Mpint128 Mpint128::Invert() const
+{
+    const Mpint128 e1 = *this;
+    const Mpint128 e2 = e1.SquareTimes(1) * e1;
+    const Mpint128 e3 = e2.SquareTimes(1) * e1;
+    const Mpint128 e5 = e3.SquareTimes(2) * e2;
+    const Mpint128 e10 = e5.SquareTimes(5) * e5;
+    const Mpint128 e20 = e10.SquareTimes(10) * e10;
+    const Mpint128 e40 = e20.SquareTimes(20) * e20;
+    const Mpint128 e80 = e40.SquareTimes(40) * e40;
+    const Mpint128 e120 = e80.SquareTimes(40) * e40;
+    const Mpint128 e125 = e120.SquareTimes(5) * e5;
+    return e125.SquareTimes(2) * e1;
+}
+
+constexpr Mpint128 Mpint128::Pow(uint64_t exp) const
+{
+    Mpint128 result((uint64_t)1);
+    Mpint128 base = *this;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result *= base;
+        }
+        exp >>= 1;
+        if (exp > 0)
+        {
+            base = base.Square();
+        }
+    }
+    return result;
+}
+
+constexpr Mpint128 Mpint128::operator+(const Mpint128& op) const
+{
+    Mpint128 result = *this;
+    result += op;
+    return result;
+}
+
+// Sums are below 2^128 - 2
+constexpr Mpint128& Mpint128::operator+=(const Mpint128& op)
+{
+    mLow += op.mLow;
+    mHigh += op.mHigh + (mLow < op.mLow ? 1u : 0u);
+    Reduce(mLow, mHigh);
+    return *this;
+}
+
+constexpr Mpint128 Mpint128::operator-(const Mpint128& op) const
+{
+    Mpint128 result = *this;
+    result -= op;
+    return result;
+}
+
+// A negative difference sets bit 127, and adding p to it clears that bit and subtracts 1
+constexpr Mpint128& Mpint128::operator-=(const Mpint128& op)
+{
+    const uint64_t borrow = mLow < op.mLow ? 1u : 0u;
+    mLow -= op.mLow;
+    mHigh -= op.mHigh + borrow;
+
+    const uint64_t isNegative = mHigh >> 63;
+    mHigh &= HIGH_MASK;
+    mHigh -= mLow < isNegative ? 1u : 0u;
+    mLow -= isNegative;
+    return *this;
+}
+
+constexpr Mpint128 Mpint128::operator-() const
+{
+    return Mpint128() - *this;
+}
+
+// Schoolbook product of the limbs, whose high limbs are below 2^63 so that no column overflows its carries
+constexpr Mpint128 Mpint128::operator*(const Mpint128& op) const
+{
+    uint64_t high00 = 0u, high01 = 0u, high10 = 0u, high11 = 0u;
+    const uint64_t low00 = MultiplyWide(mLow, op.mLow, high00);
+    const uint64_t low01 = MultiplyWide(mLow, op.mHigh, high01);
+    const uint64_t low10 = MultiplyWide(mHigh, op.mLow, high10);
+    const uint64_t low11 = MultiplyWide(mHigh, op.mHigh, high11);
+
+    uint64_t r1 = high00 + low01;
+    uint64_t carry = r1 < low01 ? 1u : 0u;
+    r1 += low10;
+    carry += r1 < low10 ? 1u : 0u;
+
+    uint64_t r2 = high01 + carry + high10;
+    carry = r2 < high10 ? 1u : 0u;
+    r2 += low11;
+    carry += r2 < low11 ? 1u : 0u;
+
+    return Fold(low00, r1, r2, high11 + carry);
+}
+
+constexpr Mpint128& Mpint128::operator*=(const Mpint128& op)
+{
+    *this = (*this) * op;
+    return *this;
+}
+
+constexpr Mpint128 Mpint128::operator/(const Mpint128& op) const
+{
+    return (*this) * op.Invert();
+}
+
+constexpr Mpint128& Mpint128::operator/=(const Mpint128& op)
+{
+    *this = (*this) * op.Invert();
+    return *this;
+}
+
+constexpr bool Mpint128::operator==(const Mpint128& op) const
+{
+    return mLow == op.mLow && mHigh == op.mHigh;
+}
+
+constexpr bool Mpint128::operator!=(const Mpint128& op) const
+{
+    return mLow != op.mLow || mHigh != op.mHigh;
+}
+
+constexpr uint64_t Mpint128::MultiplyWide(uint64_t x, uint64_t y, uint64_t& high)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const uint64_t lowX = x & 0xFFFFFFFF;
+    const uint64_t highX = x >> 32;
+    const uint64_t lowY = y & 0xFFFFFFFF;
+    const uint64_t highY = y >> 32;
+
+    const uint64_t lowLow = lowX * lowY;
+    const uint64_t middle0 = highX * lowY + (lowLow >> 32);
+    const uint64_t middle1 = lowX * highY + (middle0 & 0xFFFFFFFF);
+    high = highX * highY + (middle0 >> 32) + (middle1 >> 32);
+    return (middle1 << 32) | (lowLow & 0xFFFFFFFF);
+#else
+    const unsigned __int128 product = (unsigned __int128)x * y;
+    high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#endif
+}
+
+// x = high * 2^64 + low < 2^128 - 1 to x mod p : folding bit 127 once leaves at most p, which is mapped to 0
+constexpr void Mpint128::Reduce(uint64_t& low, uint64_t& high)
+{
+    const uint64_t top = high >> 63;
+    low += top;
+    high = (high & HIGH_MASK) + (low < top ? 1u : 0u);
+    if (low == ~(uint64_t)0 && high == HIGH_MASK)
+    {
+        low = 0u;
+        high = 0u;
+    }
+}
+
+// 256-bit r3 : r2 : r1 : r0 below 2^254 is x = q * 2^127 + r = q + r (mod p), and q + r < 2^128 - 1
+constexpr Mpint128 Mpint128::Fold(uint64_t r0, uint64_t r1, uint64_t r2, uint64_t r3)
+{
+    const uint64_t quotientLow = (r1 >> 63) | (r2 << 1);
+    const uint64_t quotientHigh = (r2 >> 63) | (r3 << 1);
+
+    Mpint128 result;
+    result.mLow = r0 + quotientLow;
+    result.mHigh = (r1 & HIGH_MASK) + quotientHigh + (result.mLow < quotientLow ? 1u : 0u);
+    Reduce(result.mLow, result.mHigh);
+    return result;
+}
+
+constexpr bool Mpint128::IsBase() const
+{
+    return mLow == ~(uint64_t)0 && mHigh == HIGH_MASK;
+}
+
+// The cross product is taken once and doubled, which fits 128 bits as the high limb is below 2^63
+constexpr Mpint128 Mpint128::Square() const
+{
+    uint64_t high00 = 0u, high01 = 0u, high11 = 0u;
+    const uint64_t low00 = MultiplyWide(mLow, mLow, high00);
+    const uint64_t low01 = MultiplyWide(mLow, mHigh, high01);
+    const uint64_t low11 = MultiplyWide(mHigh, mHigh, high11);
+
+    const uint64_t crossLow = low01 << 1;
+    const uint64_t crossHigh = (high01 << 1) | (low01 >> 63);
+
+    const uint64_t r1 = high00 + crossLow;
+    uint64_t r2 = crossHigh + (r1 < crossLow ? 1u : 0u);
+    uint64_t carry = r2 < crossHigh ? 1u : 0u;
+    r2 += low11;
+    carry += r2 < low11 ? 1u : 0u;
+
+    return Fold(low00, r1, r2, high11 + carry);
+}
+
+constexpr Mpint128 Mpint128::SquareTimes(size_t n) const
+{
+    Mpint128 result = *this;
+    for (size_t i = 0; i < n; ++i)
+    {
+        result = result.Square();
+    }
+    return result;
+}
+
+/* PackedCodec<Mpint128> */
+
+constexpr size_t PackedCodec<Mpint128>::GetPackedBytes(const size_t length)
+{
+    return BitPacking::GetPackedBytes(length, BITS);
+}
+
+inline void PackedCodec<Mpint128>::Pack(unsigned char* dst, const Mpint128* src, const size_t length)
+{
+    uint64_t* const highs = new uint64_t[length];
+    for (size_t i = 0; i < length; ++i)
+    {
+        const uint64_t low = src[i].GetValue();
+        std::memcpy(dst + i * sizeof(uint64_t), &low, sizeof(uint64_t));
+        highs[i] = src[i].GetHighValue();
+    }
+    BitPacking::Pack<BITS - 64>(dst + length * sizeof(uint64_t), highs, length);
+    delete[] highs;
+}
+
+inline void PackedCodec<Mpint128>::Unpack(Mpint128* dst, const unsigned char* src, const size_t length)
+{
+    uint64_t* const highs = new uint64_t[length];
+    BitPacking::Unpack<BITS - 64>(highs, src + length * sizeof(uint64_t), length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        unsigned char bytes[2 * sizeof(uint64_t)];
+        std::memcpy(bytes, src + i * sizeof(uint64_t), sizeof(uint64_t));
+        std::memcpy(bytes + sizeof(uint64_t), &highs[i], sizeof(uint64_t));
+        dst[i] = Mpint128(bytes);
+    }
+    delete[] highs;
+}
+
+#endif
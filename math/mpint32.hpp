@@ -1,57 +1,447 @@
 #ifndef MPINT32_H
 #define MPINT32_H
 
-#include <random>
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
 #include <stdint.h>
 
+#include "../math/chacha_prg.hpp"
+#include "../math/reduction_policy.hpp"
 
-/* 32-bit Integer over Mersenne Prime Field : Z_{2^31 - 1} */
-class Mpint32
+/* 32-bit Integer over Mersenne Prime Field : Z_{2^31 - 1}, reduced as the Policy says (reduction_policy.hpp) */
+template <typename Policy> class BasicMpint32
 {
 public:
-    Mpint32();
-    Mpint32(uint32_t value);
-    Mpint32(unsigned char* addr);
+    constexpr BasicMpint32();
+    template <std::integral T> constexpr BasicMpint32(T value);
+    BasicMpint32(unsigned char* addr);
 
-    static const uint32_t GetBase();
-    static const uint32_t GetSeed();
-    const uint32_t GetValue() const;
+    static constexpr uint32_t GetBase();
+    static uint32_t GetSeed();
+    constexpr uint32_t GetValue() const;          // Canonical value
+    constexpr uint32_t GetRepresentation() const; // Stored value, below 2p
 
     static void SetSeed(uint32_t seed);
 
-    static Mpint32 GenerateRandom();
-    static Mpint32 GenerateRandomAbove(uint32_t min);
-    static void Reverse(Mpint32* begin, Mpint32* end);
-
-    Mpint32 Invert() const;
-    Mpint32 Pow(uint32_t exp) const;
-
-    Mpint32 operator+(const Mpint32& op);
-    Mpint32& operator+=(const Mpint32& op);
-    Mpint32 operator-(const Mpint32& op);
-    Mpint32& operator-=(const Mpint32& op);
-    Mpint32 operator-();
-    Mpint32 operator*(const Mpint32& op);
-    Mpint32& operator*=(const Mpint32& op);
-    Mpint32 operator/(const Mpint32& op);
-    Mpint32& operator/=(const Mpint32& op);
-    bool operator==(const Mpint32& op);
-    bool operator>(const Mpint32& op);
-    bool operator<(const Mpint32& op);
-    bool operator>=(const Mpint32& op);
-    bool operator<=(const Mpint32& op);
-    bool operator!=(const Mpint32& op);
+    static BasicMpint32 GenerateRandom();
+    static BasicMpint32 GenerateRandomAbove(uint32_t min);
+    static void FillRandom(BasicMpint32* values, const size_t length);
+    static void Reverse(BasicMpint32* begin, BasicMpint32* end);
+    static void BatchInvert(std::span<BasicMpint32> values);
+    static void Canonicalize(BasicMpint32* values, const size_t length);
+
+    enum class InversionMethod
+    {
+        BinaryExponentiation,
+        AdditionChain,
+        Divstep
+    };
+
+    // Chosen from PerformanceMeasurement::CompareInt31Inversion
+    static constexpr InversionMethod INVERSION_METHOD = InversionMethod::AdditionChain;
+
+    constexpr BasicMpint32 Invert() const;
+    constexpr BasicMpint32 InvertByBinaryExponentiation() const;
+    constexpr BasicMpint32 InvertByAdditionChain() const;
+    constexpr BasicMpint32 InvertByDivstep() const;
+    constexpr BasicMpint32 Pow(uint32_t exp) const;
+
+    constexpr BasicMpint32 operator+(const BasicMpint32& op) const;
+    constexpr BasicMpint32& operator+=(const BasicMpint32& op);
+    constexpr BasicMpint32 operator-(const BasicMpint32& op) const;
+    constexpr BasicMpint32& operator-=(const BasicMpint32& op);
+    constexpr BasicMpint32 operator-() const;
+    constexpr BasicMpint32 operator*(const BasicMpint32& op) const;
+    constexpr BasicMpint32& operator*=(const BasicMpint32& op);
+    constexpr BasicMpint32 operator/(const BasicMpint32& op) const;
+    constexpr BasicMpint32& operator/=(const BasicMpint32& op);
+    constexpr bool operator==(const BasicMpint32& op) const;
+    constexpr bool operator>(const BasicMpint32& op) const;
+    constexpr bool operator<(const BasicMpint32& op) const;
+    constexpr bool operator>=(const BasicMpint32& op) const;
+    constexpr bool operator<=(const BasicMpint32& op) const;
+    constexpr bool operator!=(const BasicMpint32& op) const;
 
 private:
-    static const uint32_t BASE = 0x7FFFFFFF; // 2^31 - 1 (Mersenne prime)
-    static uint32_t sSeed;                   // Random seed
-    static std::mt19937 sRandomGenerator;
-    static std::uniform_int_distribution<uint32_t> sDistribution;
+    static constexpr uint32_t BASE = 0x7FFFFFFF; // 2^31 - 1 (Mersenne prime)
+    static uint32_t sSeed;                       // Random seed
 
     uint32_t mValue;
 
-    static uint32_t ReduceInt32(uint32_t x);
-    static uint64_t Reduce(uint64_t x);
+    static constexpr uint64_t Reduce(uint64_t x);
+    static constexpr uint32_t ReduceCanonically(uint32_t x);
+    static constexpr uint64_t SubtractBaseIfAbove(uint64_t x);
+
+    constexpr BasicMpint32 SquareTimes(size_t n) const;
 };
 
+// Canonical policy chosen from PerformanceMeasurement::CompareReductionPolicies, as VectorKernel<Mpint32> needs
+using Mpint32 = BasicMpint32<EagerReduction>;
+
+/* Initialize static members */
+template <typename Policy> inline uint32_t BasicMpint32<Policy>::sSeed = 0u;
+
+/* Define member functions */
+template <typename Policy> constexpr BasicMpint32<Policy>::BasicMpint32() : mValue(0u)
+{
+}
+
+template <typename Policy>
+template <std::integral T>
+constexpr BasicMpint32<Policy>::BasicMpint32(T value) : mValue((uint32_t)Reduce((uint64_t)value))
+{
+}
+
+template <typename Policy> BasicMpint32<Policy>::BasicMpint32(unsigned char* addr)
+{
+    std::memcpy(&mValue, addr, sizeof(uint32_t));
+    mValue = (uint32_t)Reduce(mValue >> 1);
+}
+
+template <typename Policy> constexpr uint32_t BasicMpint32<Policy>::GetBase()
+{
+    return BASE;
+}
+
+template <typename Policy> uint32_t BasicMpint32<Policy>::GetSeed()
+{
+    return sSeed;
+}
+
+template <typename Policy> constexpr uint32_t BasicMpint32<Policy>::GetValue() const
+{
+    return ReduceCanonically(mValue);
+}
+
+template <typename Policy> constexpr uint32_t BasicMpint32<Policy>::GetRepresentation() const
+{
+    return mValue;
+}
+
+template <typename Policy> void BasicMpint32<Policy>::SetSeed(uint32_t seed)
+{
+    sSeed = seed;
+    ChaChaPrg::SetGlobalSeed(seed);
+}
+
+template <typename Policy> BasicMpint32<Policy> BasicMpint32<Policy>::GenerateRandom()
+{
+    BasicMpint32 value;
+    FillRandom(&value, 1);
+    return value;
+}
+
+template <typename Policy> BasicMpint32<Policy> BasicMpint32<Policy>::GenerateRandomAbove(uint32_t min)
+{
+    assert(min < BASE);
+
+    BasicMpint32 value;
+    do
+    {
+        FillRandom(&value, 1);
+    } while (value.mValue < min);
+    return value;
+}
+
+// Uniform over [0, p) : masked words are all in range except p itself, which is redrawn
+template <typename Policy> void BasicMpint32<Policy>::FillRandom(BasicMpint32* values, const size_t length)
+{
+    ChaChaPrg& prg = ChaChaPrg::GetThreadLocal();
+    prg.Fill((uint32_t*)values, length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        values[i].mValue &= BASE;
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+        while (values[i].mValue == BASE)
+        {
+            values[i].mValue = (uint32_t)prg.Next32() & BASE;
+        }
+    }
+}
+
+// Montgomery's trick : one inversion and 3(n - 1) multiplications, zeros are left as they are like Invert()
+template <typename Policy> void BasicMpint32<Policy>::BatchInvert(std::span<BasicMpint32> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    const BasicMpint32 zero((uint32_t)0);
+    BasicMpint32* const prefixes = new BasicMpint32[values.size()];
+    BasicMpint32 product((uint32_t)1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        prefixes[i] = product;
+        if (values[i] != zero)
+        {
+            product *= values[i];
+        }
+    }
+
+    BasicMpint32 inverse = product.Invert();
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        if (values[i] != zero)
+        {
+            const BasicMpint32 value = values[i];
+            values[i] = inverse * prefixes[i];
+            inverse *= value;
+        }
+    }
+
+    delete[] prefixes;
+}
+
+template <typename Policy> void BasicMpint32<Policy>::Canonicalize(BasicMpint32* values, const size_t length)
+{
+    if constexpr (!Policy::IS_CANONICAL)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            values[i].mValue = ReduceCanonically(values[i].mValue);
+        }
+    }
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::Invert() const
+{
+    if constexpr (INVERSION_METHOD == InversionMethod::AdditionChain)
+    {
+        return InvertByAdditionChain();
+    }
+    else if constexpr (INVERSION_METHOD == InversionMethod::Divstep)
+    {
+        return InvertByDivstep();
+    }
+    else
+    {
+        return InvertByBinaryExponentiation();
+    }
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::InvertByBinaryExponentiation() const
+{
+    return this->Pow(BASE - 2);
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::InvertByAdditionChain() const
+{
+    // p - 2 = 2^31 - 3 = (2^29 - 1) * 2^2 + 1, where e(k) = x^(2^k - 1) and e(a + b) = e(a)^(2^b) * e(b)
+    const BasicMpint32 e1 = *this;
+    const BasicMpint32 e2 = e1.SquareTimes(1) * e1;
+    const BasicMpint32 e3 = e2.SquareTimes(1) * e1;
+    const BasicMpint32 e6 = e3.SquareTimes(3) * e3;
+    const BasicMpint32 e12 = e6.SquareTimes(6) * e6;
+    const BasicMpint32 e24 = e12.SquareTimes(12) * e12;
+    const BasicMpint32 e27 = e24.SquareTimes(3) * e3;
+    const BasicMpint32 e29 = e27.SquareTimes(2) * e2;
+    return e29.SquareTimes(2) * e1;
+}
+
+// Constant-time Bernstein-Yang divsteps : f = d * x and g = e * x (mod p) hold throughout, and f ends at +-1
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::InvertByDivstep() const
+{
+    const size_t nIterations = 94; // Enough to reach g = 0 for 31-bit inputs
+    int64_t delta = 1;
+    int64_t f = (int64_t)BASE;
+    int64_t g = (int64_t)ReduceCanonically(mValue);
+    uint64_t d = 0u;
+    uint64_t e = 1u;
+
+    for (size_t i = 0; i < nIterations; ++i)
+    {
+        // If delta > 0 and g is odd : (delta, f, g, d, e) <- (-delta, g, -f, e, -d)
+        const int64_t isOdd = -(g & 1);
+        const int64_t swap = isOdd & ((-delta) >> 63);
+        const uint64_t swapMask = (uint64_t)swap;
+
+        const int64_t fg = (f ^ g) & swap;
+        f ^= fg;
+        g ^= fg;
+        g = (g ^ swap) - swap;
+        delta = (delta ^ swap) - swap;
+
+        const uint64_t de = (d ^ e) & swapMask;
+        d ^= de;
+        e ^= de;
+        e = (e & ~swapMask) | (SubtractBaseIfAbove(BASE - e) & swapMask);
+
+        // If g is odd : (g, e) <- (g + f, e + d), then halve both
+        ++delta;
+        g += f & isOdd;
+        e = SubtractBaseIfAbove(e + (d & (uint64_t)isOdd));
+        g >>= 1;
+        e = (e + (BASE & (0u - (e & 1u)))) >> 1;
+    }
+
+    const uint64_t isNegative = (uint64_t)(f >> 63);
+    return BasicMpint32((uint32_t)((d & ~isNegative) | (SubtractBaseIfAbove(BASE - d) & isNegative)));
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::Pow(uint32_t exp) const
+{
+    uint64_t result = 1u;
+    uint64_t base = mValue;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result = Reduce(result * base);
+        }
+        exp = exp >> 1;
+        base = Reduce(base * base);
+    }
+    return BasicMpint32((uint32_t)result);
+}
+
+template <typename Policy> void BasicMpint32<Policy>::Reverse(BasicMpint32* begin, BasicMpint32* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        BasicMpint32 temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::operator+(const BasicMpint32& op) const
+{
+    BasicMpint32 result;
+    result.mValue = (uint32_t)Reduce((uint64_t)this->mValue + op.mValue);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy>& BasicMpint32<Policy>::operator+=(const BasicMpint32& op)
+{
+    this->mValue = (uint32_t)Reduce((uint64_t)this->mValue + op.mValue);
+    return *this;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::operator-(const BasicMpint32& op) const
+{
+    BasicMpint32 result;
+    result.mValue = (uint32_t)Reduce((uint64_t)this->mValue + 2u * BASE - op.mValue);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy>& BasicMpint32<Policy>::operator-=(const BasicMpint32& op)
+{
+    this->mValue = (uint32_t)Reduce((uint64_t)this->mValue + 2u * BASE - op.mValue);
+    return *this;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::operator-() const
+{
+    BasicMpint32 result;
+    result.mValue = (uint32_t)Reduce(2u * (uint64_t)BASE - this->mValue);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::operator*(const BasicMpint32& op) const
+{
+    uint64_t a = this->mValue;
+    uint64_t b = op.mValue;
+    BasicMpint32 result;
+    result.mValue = (uint32_t)Reduce(a * b);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy>& BasicMpint32<Policy>::operator*=(const BasicMpint32& op)
+{
+    uint64_t a = this->mValue;
+    uint64_t b = op.mValue;
+    this->mValue = (uint32_t)(Reduce(a * b));
+    return *this;
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::operator/(const BasicMpint32& op) const
+{
+    return (*this) * op.Invert();
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy>& BasicMpint32<Policy>::operator/=(const BasicMpint32& op)
+{
+    uint64_t a = this->mValue;
+    uint64_t b = op.Invert().mValue;
+    this->mValue = (uint32_t)(Reduce(a * b));
+    return *this;
+}
+
+template <typename Policy> constexpr bool BasicMpint32<Policy>::operator==(const BasicMpint32& op) const
+{
+    return this->GetValue() == op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint32<Policy>::operator>(const BasicMpint32& op) const
+{
+    return this->GetValue() > op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint32<Policy>::operator<(const BasicMpint32& op) const
+{
+    return this->GetValue() < op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint32<Policy>::operator>=(const BasicMpint32& op) const
+{
+    return this->GetValue() >= op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint32<Policy>::operator<=(const BasicMpint32& op) const
+{
+    return this->GetValue() <= op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint32<Policy>::operator!=(const BasicMpint32& op) const
+{
+    return this->GetValue() != op.GetValue();
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint32<Policy>::Reduce(uint64_t x)
+{
+    // Fold twice since 2^31 = 1 (mod 2^31 - 1) : any 64-bit x is below 2^31 + 8 < 2p after the second fold
+    uint64_t r = (x >> 31) + (x & BASE);
+    r = (r >> 31) + (r & BASE);
+    return Policy::Finish(r, (uint64_t)BASE);
+}
+
+// Representation below 2p to [0, p), whatever the policy
+template <typename Policy> constexpr uint32_t BasicMpint32<Policy>::ReduceCanonically(uint32_t x)
+{
+    if constexpr (Policy::IS_CANONICAL)
+    {
+        return x;
+    }
+    else
+    {
+        return (uint32_t)SubtractBaseIfAbove(x);
+    }
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint32<Policy>::SubtractBaseIfAbove(uint64_t x)
+{
+    return x - (BASE & (0u - (uint64_t)(x >= BASE)));
+}
+
+template <typename Policy> constexpr BasicMpint32<Policy> BasicMpint32<Policy>::SquareTimes(size_t n) const
+{
+    uint64_t value = mValue;
+    for (size_t i = 0; i < n; ++i)
+    {
+        value = Reduce(value * value);
+    }
+    return BasicMpint32((uint32_t)value);
+}
+
 #endif
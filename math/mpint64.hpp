@@ -1,58 +1,474 @@
 #ifndef MPINT64_H
 #define MPINT64_H
 
-#include <random>
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
 #include <stdint.h>
 
-/* 64-bit Integer over Mersenne Prime Field : Z_{2^61 - 1} */
-class Mpint64
+#include "../math/chacha_prg.hpp"
+#include "../math/reduction_policy.hpp"
+
+/* 64-bit Integer over Mersenne Prime Field : Z_{2^61 - 1}, reduced as the Policy says (reduction_policy.hpp) */
+template <typename Policy> class BasicMpint64
 {
 public:
-    Mpint64();
-    Mpint64(uint64_t value);
-    Mpint64(unsigned char* addr);
+    constexpr BasicMpint64();
+    template <std::integral T> constexpr BasicMpint64(T value);
+    BasicMpint64(unsigned char* addr);
 
-    static const uint64_t GetBase();
-    static const uint32_t GetSeed();
-    const uint64_t GetValue() const;
+    static constexpr uint64_t GetBase();
+    static uint32_t GetSeed();
+    constexpr uint64_t GetValue() const;          // Canonical value
+    constexpr uint64_t GetRepresentation() const; // Stored value, below 2p
 
     static void SetSeed(uint32_t seed);
 
-    static Mpint64 GenerateRandom();
-    static Mpint64 GenerateRandomAbove(uint64_t min);
-    static void Reverse(Mpint64* begin, Mpint64* end);
-
-    Mpint64 Invert() const;
-    Mpint64 Pow(uint64_t exp) const;
-
-    Mpint64 operator+(const Mpint64& op);
-    Mpint64& operator+=(const Mpint64& op);
-    Mpint64 operator-(const Mpint64& op);
-    Mpint64& operator-=(const Mpint64& op);
-    Mpint64 operator-();
-    Mpint64 operator*(const Mpint64& op);
-    Mpint64& operator*=(const Mpint64& op);
-    Mpint64 operator/(const Mpint64& op);
-    Mpint64& operator/=(const Mpint64& op);
-    bool operator==(const Mpint64& op);
-    bool operator>(const Mpint64& op);
-    bool operator<(const Mpint64& op);
-    bool operator>=(const Mpint64& op);
-    bool operator<=(const Mpint64& op);
-    bool operator!=(const Mpint64& op);
+    static BasicMpint64 GenerateRandom();
+    static BasicMpint64 GenerateRandomAbove(uint64_t min);
+    static void FillRandom(BasicMpint64* values, const size_t length);
+    static void Reverse(BasicMpint64* begin, BasicMpint64* end);
+    static void BatchInvert(std::span<BasicMpint64> values);
+    static void Canonicalize(BasicMpint64* values, const size_t length);
+
+    enum class InversionMethod
+    {
+        BinaryExponentiation,
+        AdditionChain,
+        Divstep
+    };
+
+    // Chosen from PerformanceMeasurement::CompareInt61Inversion
+    static constexpr InversionMethod INVERSION_METHOD = InversionMethod::AdditionChain;
+
+    constexpr BasicMpint64 Invert() const;
+    constexpr BasicMpint64 InvertByBinaryExponentiation() const;
+    constexpr BasicMpint64 InvertByAdditionChain() const;
+    constexpr BasicMpint64 InvertByDivstep() const;
+    constexpr BasicMpint64 Pow(uint64_t exp) const;
+
+    constexpr BasicMpint64 operator+(const BasicMpint64& op) const;
+    constexpr BasicMpint64& operator+=(const BasicMpint64& op);
+    constexpr BasicMpint64 operator-(const BasicMpint64& op) const;
+    constexpr BasicMpint64& operator-=(const BasicMpint64& op);
+    constexpr BasicMpint64 operator-() const;
+    constexpr BasicMpint64 operator*(const BasicMpint64& op) const;
+    constexpr BasicMpint64& operator*=(const BasicMpint64& op);
+    constexpr BasicMpint64 operator/(const BasicMpint64& op) const;
+    constexpr BasicMpint64& operator/=(const BasicMpint64& op);
+    constexpr bool operator==(const BasicMpint64& op) const;
+    constexpr bool operator>(const BasicMpint64& op) const;
+    constexpr bool operator<(const BasicMpint64& op) const;
+    constexpr bool operator>=(const BasicMpint64& op) const;
+    constexpr bool operator<=(const BasicMpint64& op) const;
+    constexpr bool operator!=(const BasicMpint64& op) const;
 
 private:
-    static const uint64_t BASE = 0x1FFFFFFFFFFFFFFF; // 2^61 - 1 (Mersenne prime)
-    static const uint64_t MASK = 0xFFFFFFFF;         // 2^32 - 1
-    static uint32_t sSeed;                           // Random seed
-    static std::mt19937 sRandomGenerator;
-    static std::uniform_int_distribution<uint64_t> sDistribution;
+    static constexpr uint64_t BASE = 0x1FFFFFFFFFFFFFFF; // 2^61 - 1 (Mersenne prime)
+    static constexpr uint64_t MASK = 0xFFFFFFFF;         // 2^32 - 1
+    static uint32_t sSeed;                               // Random seed
 
     uint64_t mValue;
 
-    static uint64_t Reduce(uint64_t x);
-    static uint64_t ReduceIncompletely(uint64_t x);
-    static uint64_t Multiply(uint64_t x, uint64_t y);
+    static constexpr uint64_t Reduce(uint64_t x);
+    static constexpr uint64_t ReduceCanonically(uint64_t x);
+    static constexpr uint64_t SubtractBaseIfAbove(uint64_t x);
+
+    constexpr BasicMpint64 SquareTimes(size_t n) const;
+    static constexpr uint64_t ReduceIncompletely(uint64_t x);
+    static constexpr uint64_t Multiply(uint64_t x, uint64_t y);
 };
 
+// Chosen from PerformanceMeasurement::CompareReductionPolicies
+using Mpint64 = BasicMpint64<LazyReduction>;
+
+/* Initialize static members */
+template <typename Policy> inline uint32_t BasicMpint64<Policy>::sSeed = 0u;
+
+/* Define member functions */
+template <typename Policy> constexpr BasicMpint64<Policy>::BasicMpint64() : mValue(0u)
+{
+}
+
+template <typename Policy>
+template <std::integral T>
+constexpr BasicMpint64<Policy>::BasicMpint64(T value) : mValue(Reduce((uint64_t)value))
+{
+}
+
+template <typename Policy> BasicMpint64<Policy>::BasicMpint64(unsigned char* addr)
+{
+    std::memcpy(&mValue, addr, sizeof(uint64_t));
+    mValue = Reduce(mValue >> 3);
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::GetBase()
+{
+    return BASE;
+}
+
+template <typename Policy> uint32_t BasicMpint64<Policy>::GetSeed()
+{
+    return sSeed;
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::GetValue() const
+{
+    return ReduceCanonically(mValue);
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::GetRepresentation() const
+{
+    return mValue;
+}
+
+template <typename Policy> void BasicMpint64<Policy>::SetSeed(uint32_t seed)
+{
+    sSeed = seed;
+    ChaChaPrg::SetGlobalSeed(seed);
+}
+
+template <typename Policy> BasicMpint64<Policy> BasicMpint64<Policy>::GenerateRandom()
+{
+    BasicMpint64 value;
+    FillRandom(&value, 1);
+    return value;
+}
+
+template <typename Policy> BasicMpint64<Policy> BasicMpint64<Policy>::GenerateRandomAbove(uint64_t min)
+{
+    assert(min < BASE);
+
+    BasicMpint64 value;
+    do
+    {
+        FillRandom(&value, 1);
+    } while (value.mValue < min);
+    return value;
+}
+
+// Uniform over [0, p) : masked words are all in range except p itself, which is redrawn
+template <typename Policy> void BasicMpint64<Policy>::FillRandom(BasicMpint64* values, const size_t length)
+{
+    ChaChaPrg& prg = ChaChaPrg::GetThreadLocal();
+    prg.Fill((uint64_t*)values, length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        values[i].mValue &= BASE;
+    }
+    for (size_t i = 0; i < length; ++i)
+    {
+        while (values[i].mValue == BASE)
+        {
+            values[i].mValue = (uint64_t)prg.Next64() & BASE;
+        }
+    }
+}
+
+template <typename Policy> void BasicMpint64<Policy>::Reverse(BasicMpint64* begin, BasicMpint64* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        BasicMpint64 temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+// Montgomery's trick : one inversion and 3(n - 1) multiplications, zeros are left as they are like Invert()
+template <typename Policy> void BasicMpint64<Policy>::BatchInvert(std::span<BasicMpint64> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    const BasicMpint64 zero((uint64_t)0);
+    BasicMpint64* const prefixes = new BasicMpint64[values.size()];
+    BasicMpint64 product((uint64_t)1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        prefixes[i] = product;
+        if (values[i] != zero)
+        {
+            product *= values[i];
+        }
+    }
+
+    BasicMpint64 inverse = product.Invert();
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        if (values[i] != zero)
+        {
+            const BasicMpint64 value = values[i];
+            values[i] = inverse * prefixes[i];
+            inverse *= value;
+        }
+    }
+
+    delete[] prefixes;
+}
+
+template <typename Policy> void BasicMpint64<Policy>::Canonicalize(BasicMpint64* values, const size_t length)
+{
+    if constexpr (!Policy::IS_CANONICAL)
+    {
+        for (size_t i = 0; i < length; ++i)
+        {
+            values[i].mValue = ReduceCanonically(values[i].mValue);
+        }
+    }
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::Invert() const
+{
+    if constexpr (INVERSION_METHOD == InversionMethod::AdditionChain)
+    {
+        return InvertByAdditionChain();
+    }
+    else if constexpr (INVERSION_METHOD == InversionMethod::Divstep)
+    {
+        return InvertByDivstep();
+    }
+    else
+    {
+        return InvertByBinaryExponentiation();
+    }
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::InvertByBinaryExponentiation() const
+{
+    return this->Pow(BASE - 2);
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::InvertByAdditionChain() const
+{
+    // p - 2 = 2^61 - 3 = (2^59 - 1) * 2^2 + 1, where e(k) = x^(2^k - 1) and e(a + b) = e(a)^(2^b) * e(b)
+    const BasicMpint64 e1 = *this;
+    const BasicMpint64 e2 = e1.SquareTimes(1) * e1;
+    const BasicMpint64 e3 = e2.SquareTimes(1) * e1;
+    const BasicMpint64 e6 = e3.SquareTimes(3) * e3;
+    const BasicMpint64 e8 = e6.SquareTimes(2) * e2;
+    const BasicMpint64 e12 = e6.SquareTimes(6) * e6;
+    const BasicMpint64 e24 = e12.SquareTimes(12) * e12;
+    const BasicMpint64 e48 = e24.SquareTimes(24) * e24;
+    const BasicMpint64 e56 = e48.SquareTimes(8) * e8;
+    const BasicMpint64 e59 = e56.SquareTimes(3) * e3;
+    return e59.SquareTimes(2) * e1;
+}
+
+// Constant-time Bernstein-Yang divsteps : f = d * x and g = e * x (mod p) hold throughout, and f ends at +-1
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::InvertByDivstep() const
+{
+    const size_t nIterations = 179; // Enough to reach g = 0 for 61-bit inputs
+    int64_t delta = 1;
+    int64_t f = (int64_t)BASE;
+    int64_t g = (int64_t)ReduceCanonically(mValue);
+    uint64_t d = 0u;
+    uint64_t e = 1u;
+
+    for (size_t i = 0; i < nIterations; ++i)
+    {
+        // If delta > 0 and g is odd : (delta, f, g, d, e) <- (-delta, g, -f, e, -d)
+        const int64_t isOdd = -(g & 1);
+        const int64_t swap = isOdd & ((-delta) >> 63);
+        const uint64_t swapMask = (uint64_t)swap;
+
+        const int64_t fg = (f ^ g) & swap;
+        f ^= fg;
+        g ^= fg;
+        g = (g ^ swap) - swap;
+        delta = (delta ^ swap) - swap;
+
+        const uint64_t de = (d ^ e) & swapMask;
+        d ^= de;
+        e ^= de;
+        e = (e & ~swapMask) | (SubtractBaseIfAbove(BASE - e) & swapMask);
+
+        // If g is odd : (g, e) <- (g + f, e + d), then halve both
+        ++delta;
+        g += f & isOdd;
+        e = SubtractBaseIfAbove(e + (d & (uint64_t)isOdd));
+        g >>= 1;
+        e = (e + (BASE & (0u - (e & 1u)))) >> 1;
+    }
+
+    const uint64_t isNegative = (uint64_t)(f >> 63);
+    return BasicMpint64((uint64_t)((d & ~isNegative) | (SubtractBaseIfAbove(BASE - d) & isNegative)));
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::Pow(uint64_t exp) const
+{
+    uint64_t result = 1u;
+    uint64_t base = mValue;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result = Multiply(result, base);
+        }
+        exp = exp >> 1;
+        base = Multiply(base, base);
+    }
+    return BasicMpint64(result);
+}
+
+template <typename Policy>
+constexpr BasicMpint64<Policy> BasicMpint64<Policy>::operator+(const BasicMpint64& op) const
+{
+    BasicMpint64 result;
+    result.mValue = Reduce(this->mValue + op.mValue);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy>& BasicMpint64<Policy>::operator+=(const BasicMpint64& op)
+{
+    this->mValue = Reduce(this->mValue + op.mValue);
+    return *this;
+}
+
+// Operands are below 2p, so 2p keeps the difference positive
+template <typename Policy>
+constexpr BasicMpint64<Policy> BasicMpint64<Policy>::operator-(const BasicMpint64& op) const
+{
+    BasicMpint64 result;
+    result.mValue = Reduce(this->mValue + 2u * BASE - op.mValue);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy>& BasicMpint64<Policy>::operator-=(const BasicMpint64& op)
+{
+    this->mValue = Reduce(this->mValue + 2u * BASE - op.mValue);
+    return *this;
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::operator-() const
+{
+    BasicMpint64 result;
+    result.mValue = Reduce(2u * BASE - this->mValue);
+    return result;
+}
+
+template <typename Policy>
+constexpr BasicMpint64<Policy> BasicMpint64<Policy>::operator*(const BasicMpint64& op) const
+{
+    BasicMpint64 result;
+    result.mValue = Policy::Finish(Multiply(this->mValue, op.mValue), BASE);
+    return result;
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy>& BasicMpint64<Policy>::operator*=(const BasicMpint64& op)
+{
+    this->mValue = Policy::Finish(Multiply(this->mValue, op.mValue), BASE);
+    return *this;
+}
+
+template <typename Policy>
+constexpr BasicMpint64<Policy> BasicMpint64<Policy>::operator/(const BasicMpint64& op) const
+{
+    return (*this) * op.Invert();
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy>& BasicMpint64<Policy>::operator/=(const BasicMpint64& op)
+{
+    this->mValue = Policy::Finish(Multiply(this->mValue, op.Invert().mValue), BASE);
+    return *this;
+}
+
+template <typename Policy> constexpr bool BasicMpint64<Policy>::operator==(const BasicMpint64& op) const
+{
+    return this->GetValue() == op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint64<Policy>::operator>(const BasicMpint64& op) const
+{
+    return this->GetValue() > op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint64<Policy>::operator<(const BasicMpint64& op) const
+{
+    return this->GetValue() < op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint64<Policy>::operator>=(const BasicMpint64& op) const
+{
+    return this->GetValue() >= op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint64<Policy>::operator<=(const BasicMpint64& op) const
+{
+    return this->GetValue() <= op.GetValue();
+}
+
+template <typename Policy> constexpr bool BasicMpint64<Policy>::operator!=(const BasicMpint64& op) const
+{
+    return this->GetValue() != op.GetValue();
+}
+
+// One fold leaves any 64-bit x below 2^61 + 8 < 2p, from where the policy finishes
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::Reduce(uint64_t x)
+{
+    return Policy::Finish(ReduceIncompletely(x), BASE);
+}
+
+// Representation below 2p to [0, p), whatever the policy
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::ReduceCanonically(uint64_t x)
+{
+    if constexpr (Policy::IS_CANONICAL)
+    {
+        return x;
+    }
+    else
+    {
+        return SubtractBaseIfAbove(x);
+    }
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::ReduceIncompletely(uint64_t x)
+{
+    return (x >> 61) + (x & BASE);
+}
+
+// Inputs below 2^62 give a result below 2^61 + 3
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::Multiply(uint64_t x, uint64_t y)
+{
+    uint64_t hi_x = x >> 32;
+    uint64_t hi_y = y >> 32;
+    uint64_t low_x = x & MASK;
+    uint64_t low_y = y & MASK;
+
+    uint64_t piece1 = ReduceIncompletely((hi_x * hi_y) << 3);
+    uint64_t z = (hi_x * low_y + hi_y * low_x);
+    uint64_t hi_z = z >> 32;
+    uint64_t low_z = z & MASK;
+
+    uint64_t piece2 = ReduceIncompletely((hi_z << 3) + ReduceIncompletely((low_z << 32)));
+    uint64_t piece3 = ReduceIncompletely(low_x * low_y);
+    uint64_t result = ReduceIncompletely(piece1 + piece2 + piece3);
+
+    return result;
+}
+
+template <typename Policy> constexpr uint64_t BasicMpint64<Policy>::SubtractBaseIfAbove(uint64_t x)
+{
+    return x - (BASE & (0u - (uint64_t)(x >= BASE)));
+}
+
+template <typename Policy> constexpr BasicMpint64<Policy> BasicMpint64<Policy>::SquareTimes(size_t n) const
+{
+    uint64_t value = mValue;
+    for (size_t i = 0; i < n; ++i)
+    {
+        value = Multiply(value, value);
+    }
+    return BasicMpint64(value);
+}
+
 #endif
@@ -0,0 +1,184 @@
+#ifndef NTT_H
+#define NTT_H
+
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <stdint.h>
+
+/* Fields with primitive 2^k-th roots of unity for every k up to GetTwoAdicity() */
+template <typename Int> concept NttField = requires(size_t logOrder) {
+    { Int::GetTwoAdicity() } -> std::same_as<size_t>;
+    { Int::GetRootOfUnity(logOrder) } -> std::same_as<Int>;
+};
+
+/*
+ * In-place number theoretic transform of length 2^logSize with precomputed twiddle tables.
+ * Forward is decimation in frequency (natural order in, bit-reversed order out) and Inverse is decimation in time
+ * (bit-reversed order in, natural order out), so a convolution never permutes its data.
+ * Layers are fused two at a time into radix-4 butterflies, with one radix-2 layer left for odd logSize.
+ */
+template <NttField Int> class Ntt
+{
+public:
+    static constexpr size_t MAX_LOG_SIZE = 40;
+
+    Ntt(const size_t logSize);
+    Ntt(const Ntt&) = delete;
+    ~Ntt();
+
+    size_t GetSize() const;
+    void Forward(Int* values) const;
+    void Inverse(Int* values) const;
+
+    static const Ntt& GetInstance(const size_t logSize); // Tables are built once per thread and size
+
+    Ntt& operator=(const Ntt&) = delete;
+
+private:
+    size_t mLogSize;
+    size_t mSize;
+    Int* mTwiddles;        // w^k for a primitive mSize-th root of unity w, 0 <= k < mSize
+    Int* mInverseTwiddles; // w^-k
+    Int mSizeInverse;
+};
+
+template <NttField Int> Ntt<Int>::Ntt(const size_t logSize)
+{
+    assert(logSize <= Int::GetTwoAdicity() && logSize <= MAX_LOG_SIZE);
+
+    mLogSize = logSize;
+    mSize = (size_t)1 << logSize;
+    mTwiddles = new Int[mSize];
+    mInverseTwiddles = new Int[mSize];
+
+    const Int root = Int::GetRootOfUnity(logSize);
+    const Int rootInverse = root.Invert();
+    mTwiddles[0] = Int((uint64_t)1);
+    mInverseTwiddles[0] = Int((uint64_t)1);
+    for (size_t k = 1; k < mSize; ++k)
+    {
+        mTwiddles[k] = mTwiddles[k - 1] * root;
+        mInverseTwiddles[k] = mInverseTwiddles[k - 1] * rootInverse;
+    }
+    mSizeInverse = Int((uint64_t)mSize).Invert();
+}
+
+template <NttField Int> Ntt<Int>::~Ntt()
+{
+    delete[] mTwiddles;
+    delete[] mInverseTwiddles;
+}
+
+template <NttField Int> size_t Ntt<Int>::GetSize() const
+{
+    return mSize;
+}
+
+template <NttField Int> void Ntt<Int>::Forward(Int* values) const
+{
+    size_t half = mSize >> 1;
+
+    // Radix-4 : layers with halves 2q and q, where w4 = W^q is a primitive 4th root of unity
+    while (half >= 2u)
+    {
+        const size_t quarter = half >> 1;
+        const size_t stride = mSize / (quarter * 4u);
+        const Int w4 = mTwiddles[mSize >> 2];
+        for (size_t begin = 0; begin < mSize; begin += quarter * 4u)
+        {
+            Int* const x = values + begin;
+            for (size_t j = 0; j < quarter; ++j)
+            {
+                const Int t0 = x[j] + x[j + quarter * 2u];
+                const Int t1 = x[j + quarter] + x[j + quarter * 3u];
+                const Int t2 = x[j] - x[j + quarter * 2u];
+                const Int t3 = (x[j + quarter] - x[j + quarter * 3u]) * w4;
+
+                x[j] = t0 + t1;
+                x[j + quarter] = (t0 - t1) * mTwiddles[j * stride * 2u];
+                x[j + quarter * 2u] = (t2 + t3) * mTwiddles[j * stride];
+                x[j + quarter * 3u] = (t2 - t3) * mTwiddles[j * stride * 3u];
+            }
+        }
+        half >>= 2;
+    }
+
+    if (half == 1u)
+    {
+        for (size_t begin = 0; begin < mSize; begin += 2u)
+        {
+            const Int x0 = values[begin];
+            const Int x1 = values[begin + 1u];
+            values[begin] = x0 + x1;
+            values[begin + 1u] = x0 - x1;
+        }
+    }
+}
+
+template <NttField Int> void Ntt<Int>::Inverse(Int* values) const
+{
+    size_t half = 1u;
+
+    if (mLogSize % 2u == 1u)
+    {
+        for (size_t begin = 0; begin < mSize; begin += 2u)
+        {
+            const Int x0 = values[begin];
+            const Int x1 = values[begin + 1u];
+            values[begin] = x0 + x1;
+            values[begin + 1u] = x0 - x1;
+        }
+        half = 2u;
+    }
+
+    // Radix-4 : mirror of Forward with inverse twiddles
+    while (half < mSize)
+    {
+        const size_t quarter = half;
+        const size_t stride = mSize / (quarter * 4u);
+        const Int w4 = mInverseTwiddles[mSize >> 2];
+        for (size_t begin = 0; begin < mSize; begin += quarter * 4u)
+        {
+            Int* const x = values + begin;
+            for (size_t j = 0; j < quarter; ++j)
+            {
+                const Int u0 = x[j];
+                const Int u1 = x[j + quarter] * mInverseTwiddles[j * stride * 2u];
+                const Int u2 = x[j + quarter * 2u] * mInverseTwiddles[j * stride];
+                const Int u3 = x[j + quarter * 3u] * mInverseTwiddles[j * stride * 3u];
+
+                const Int t0 = u0 + u1;
+                const Int t1 = u0 - u1;
+                const Int t2 = u2 + u3;
+                const Int t3 = (u2 - u3) * w4;
+
+                x[j] = t0 + t2;
+                x[j + quarter] = t1 + t3;
+                x[j + quarter * 2u] = t0 - t2;
+                x[j + quarter * 3u] = t1 - t3;
+            }
+        }
+        half <<= 2;
+    }
+
+    for (size_t i = 0; i < mSize; ++i)
+    {
+        values[i] *= mSizeInverse;
+    }
+}
+
+template <NttField Int> const Ntt<Int>& Ntt<Int>::GetInstance(const size_t logSize)
+{
+    assert(logSize <= MAX_LOG_SIZE);
+
+    thread_local std::unique_ptr<Ntt> instances[MAX_LOG_SIZE + 1];
+    if (!instances[logSize])
+    {
+        instances[logSize] = std::make_unique<Ntt>(logSize);
+    }
+    return *instances[logSize];
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "operation_counter.hpp"
+
+#include <iomanip>
+
+thread_local std::vector<OperationCounter::Phase> OperationCounter::sPhases = {{"setup", {}}};
+thread_local size_t OperationCounter::sCurrentPhase = 0u;
+
+void OperationCounter::BeginPhase(const std::string& name)
+{
+    for (size_t i = 0; i < sPhases.size(); ++i)
+    {
+        if (sPhases[i].name == name)
+        {
+            sCurrentPhase = i;
+            return;
+        }
+    }
+    sPhases.push_back({name, {}});
+    sCurrentPhase = sPhases.size() - 1u;
+}
+
+void OperationCounter::Reset()
+{
+    sPhases.assign(1u, {"setup", {}});
+    sCurrentPhase = 0u;
+}
+
+uint64_t OperationCounter::GetCount(const std::string& phase, const Operation operation)
+{
+    for (const Phase& entry : sPhases)
+    {
+        if (entry.name == phase)
+        {
+            return entry.counts[(size_t)operation];
+        }
+    }
+    return 0u;
+}
+
+uint64_t OperationCounter::GetTotal(const Operation operation)
+{
+    uint64_t total = 0u;
+    for (const Phase& entry : sPhases)
+    {
+        total += entry.counts[(size_t)operation];
+    }
+    return total;
+}
+
+void OperationCounter::PrintReport(std::ostream& os)
+{
+    static const char* const HEADERS[(size_t)Operation::COUNT] = {"Multiplication", "Addition", "Inversion",
+                                                                   "Reduction", "Hashed bytes"};
+
+    os << std::left << std::setw(12) << "Phase";
+    for (size_t i = 0; i < (size_t)Operation::COUNT; ++i)
+    {
+        os << " | " << std::right << std::setw(14) << HEADERS[i];
+    }
+    os << std::endl;
+
+    for (const Phase& entry : sPhases)
+    {
+        os << std::left << std::setw(12) << entry.name;
+        for (size_t i = 0; i < (size_t)Operation::COUNT; ++i)
+        {
+            os << " | " << std::right << std::setw(14) << entry.counts[i];
+        }
+        os << std::endl;
+    }
+
+    os << std::left << std::setw(12) << "Total";
+    for (size_t i = 0; i < (size_t)Operation::COUNT; ++i)
+    {
+        os << " | " << std::right << std::setw(14) << GetTotal((Operation)i);
+    }
+    os << std::left << std::endl;
+}
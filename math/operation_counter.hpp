@@ -0,0 +1,52 @@
+#ifndef OPERATION_COUNTER_H
+#define OPERATION_COUNTER_H
+
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Field operation and hashing counts per protocol phase, for cost comparisons free of timing noise.
+ * Field operations are counted by CountingInt (counting_int.hpp) and hashed bytes by the random oracle calls.
+ * Counts are kept per thread : a counted run stays on the thread that reads the report, and counts made on any
+ * other thread are not part of it.
+ */
+class OperationCounter
+{
+public:
+    enum class Operation
+    {
+        Multiplication,
+        Addition, // Including subtractions and negations
+        Inversion,
+        Reduction,
+        HashedByte,
+        COUNT
+    };
+
+    static void Count(const Operation operation, const uint64_t n = 1u);
+    static void BeginPhase(const std::string& name); // Counts go to this phase until the next one begins
+    static void Reset();                             // Drops every phase and begins "setup"
+
+    static uint64_t GetCount(const std::string& phase, const Operation operation);
+    static uint64_t GetTotal(const Operation operation);
+    static void PrintReport(std::ostream& os = std::cout);
+
+private:
+    struct Phase
+    {
+        std::string name;
+        uint64_t counts[(size_t)Operation::COUNT];
+    };
+
+    static thread_local std::vector<Phase> sPhases;
+    static thread_local size_t sCurrentPhase;
+};
+
+inline void OperationCounter::Count(const Operation operation, const uint64_t n)
+{
+    sPhases[sCurrentPhase].counts[(size_t)operation] += n;
+}
+
+#endif
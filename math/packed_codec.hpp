@@ -0,0 +1,203 @@
+#ifndef PACKED_CODEC_H
+#define PACKED_CODEC_H
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdint.h>
+
+#include "../math/extension_field.hpp"
+#include "../math/vector_kernel.hpp"
+
+/* B-bit values back to back in little-endian bit order : the first value takes the lowest bits of the first byte */
+class BitPacking
+{
+public:
+    static constexpr size_t GetPackedBytes(const size_t length, const size_t bits);
+
+    template <size_t B, typename Word> static void Pack(unsigned char* dst, const Word* src, const size_t length);
+    template <size_t B, typename Word> static void Unpack(Word* dst, const unsigned char* src, const size_t length);
+};
+
+/*
+ * Wire encoding of field vectors with exactly BITS bits per element, the bit length of the modulus.
+ * Packed bytes hold canonical values, whatever the reduction policy of Int, and the last byte is zero-padded.
+ */
+template <typename Int> class PackedCodec
+{
+public:
+    static constexpr size_t BITS = std::bit_width(Int::GetBase());
+
+    static constexpr size_t GetPackedBytes(const size_t length);
+    static void Pack(unsigned char* dst, const Int* src, const size_t length);
+    static void Unpack(Int* dst, const unsigned char* src, const size_t length);
+
+private:
+    static constexpr size_t CHUNK_LENGTH = 64; // Chunks of 64 values end on a byte boundary
+};
+
+/* Extension field elements are packed as their K base field coefficients */
+template <typename Int, size_t K> class PackedCodec<Ext<Int, K>>
+{
+public:
+    static constexpr size_t BITS = K * PackedCodec<Int>::BITS;
+
+    static constexpr size_t GetPackedBytes(const size_t length);
+    static void Pack(unsigned char* dst, const Ext<Int, K>* src, const size_t length);
+    static void Unpack(Ext<Int, K>* dst, const unsigned char* src, const size_t length);
+};
+
+/* BitPacking */
+
+constexpr size_t BitPacking::GetPackedBytes(const size_t length, const size_t bits)
+{
+    return (length * bits + 7u) / 8u;
+}
+
+// Values must be below 2^B
+template <size_t B, typename Word> void BitPacking::Pack(unsigned char* dst, const Word* src, const size_t length)
+{
+    static_assert(B > 0u && B < 64u);
+
+    uint64_t buffer = 0u;
+    size_t nBits = 0u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const uint64_t value = src[i];
+        buffer |= value << nBits;
+        if (nBits + B >= 64u)
+        {
+            std::memcpy(dst, &buffer, sizeof(uint64_t));
+            dst += sizeof(uint64_t);
+            buffer = nBits == 0u ? 0u : value >> (64u - nBits);
+            nBits = nBits + B - 64u;
+        }
+        else
+        {
+            nBits += B;
+        }
+    }
+    std::memcpy(dst, &buffer, (nBits + 7u) / 8u);
+}
+
+template <size_t B, typename Word> void BitPacking::Unpack(Word* dst, const unsigned char* src, const size_t length)
+{
+    static_assert(B > 0u && B < 64u);
+
+    const uint64_t mask = ((uint64_t)1 << B) - 1u;
+    const unsigned char* const end = src + GetPackedBytes(length, B);
+    uint64_t buffer = 0u;
+    size_t nBits = 0u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (nBits >= B)
+        {
+            dst[i] = (Word)(buffer & mask);
+            buffer >>= B;
+            nBits -= B;
+        }
+        else
+        {
+            // Reads past the last byte are cut off, so the bits taken from there are never used
+            uint64_t next = 0u;
+            const size_t nRead = std::min((size_t)(end - src), sizeof(uint64_t));
+            std::memcpy(&next, src, nRead);
+            src += nRead;
+            dst[i] = (Word)((buffer | (next << nBits)) & mask);
+            buffer = next >> (B - nBits);
+            nBits = nBits + 64u - B;
+        }
+    }
+}
+
+/* PackedCodec */
+
+template <typename Int> constexpr size_t PackedCodec<Int>::GetPackedBytes(const size_t length)
+{
+    return BitPacking::GetPackedBytes(length, BITS);
+}
+
+template <typename Int> void PackedCodec<Int>::Pack(unsigned char* dst, const Int* src, const size_t length)
+{
+    uint64_t values[CHUNK_LENGTH];
+    for (size_t i = 0; i < length; i += CHUNK_LENGTH)
+    {
+        const size_t currentLength = std::min(CHUNK_LENGTH, length - i);
+        for (size_t j = 0; j < currentLength; ++j)
+        {
+            values[j] = src[i + j].GetValue();
+        }
+
+        if constexpr (BITS == 64u)
+        {
+            std::memcpy(dst + i * sizeof(uint64_t), values, currentLength * sizeof(uint64_t));
+        }
+        else
+        {
+            BitPacking::Pack<BITS>(dst + GetPackedBytes(i), values, currentLength);
+        }
+    }
+}
+
+template <typename Int> void PackedCodec<Int>::Unpack(Int* dst, const unsigned char* src, const size_t length)
+{
+    uint64_t values[CHUNK_LENGTH];
+    for (size_t i = 0; i < length; i += CHUNK_LENGTH)
+    {
+        const size_t currentLength = std::min(CHUNK_LENGTH, length - i);
+        if constexpr (BITS == 64u)
+        {
+            std::memcpy(values, src + i * sizeof(uint64_t), currentLength * sizeof(uint64_t));
+        }
+        else
+        {
+            BitPacking::Unpack<BITS>(values, src + GetPackedBytes(i), currentLength);
+        }
+
+        for (size_t j = 0; j < currentLength; ++j)
+        {
+            dst[i + j] = Int(values[j]);
+        }
+    }
+}
+
+template <> inline void PackedCodec<Mpint64>::Pack(unsigned char* dst, const Mpint64* src, const size_t length)
+{
+    VectorKernel<Mpint64>::Pack(dst, src, length);
+}
+
+template <> inline void PackedCodec<Mpint64>::Unpack(Mpint64* dst, const unsigned char* src, const size_t length)
+{
+    VectorKernel<Mpint64>::Unpack(dst, src, length);
+}
+
+template <> inline void PackedCodec<Mpint32>::Pack(unsigned char* dst, const Mpint32* src, const size_t length)
+{
+    VectorKernel<Mpint32>::Pack(dst, src, length);
+}
+
+template <> inline void PackedCodec<Mpint32>::Unpack(Mpint32* dst, const unsigned char* src, const size_t length)
+{
+    VectorKernel<Mpint32>::Unpack(dst, src, length);
+}
+
+/* PackedCodec<Ext> */
+
+template <typename Int, size_t K> constexpr size_t PackedCodec<Ext<Int, K>>::GetPackedBytes(const size_t length)
+{
+    return PackedCodec<Int>::GetPackedBytes(length * K);
+}
+
+template <typename Int, size_t K>
+void PackedCodec<Ext<Int, K>>::Pack(unsigned char* dst, const Ext<Int, K>* src, const size_t length)
+{
+    PackedCodec<Int>::Pack(dst, (const Int*)src, length * K);
+}
+
+template <typename Int, size_t K>
+void PackedCodec<Ext<Int, K>>::Unpack(Ext<Int, K>* dst, const unsigned char* src, const size_t length)
+{
+    PackedCodec<Int>::Unpack((Int*)dst, src, length * K);
+}
+
+#endif
@@ -5,281 +5,709 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
-
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "../math/accumulator.hpp"
+#include "../math/circle_fft.hpp"
+#include "../math/constant_tables.hpp"
+#include "../math/counting_int.hpp"
+#include "../math/extension_field.hpp"
+#include "../math/ntt.hpp"
+#include "../math/polynomial_multiplier.hpp"
 #include "../math/square_matrix.hpp"
+#include "../math/vector_kernel.hpp"
 
 template <typename Int> class Proof;
+template <typename Int> class PolynomialBatch;
 
 template <typename Int> class Polynomial
 {
 public:
     friend class Proof<Int>;
+    friend class PolynomialBatch<Int>;
 
     Polynomial();
     Polynomial(const Polynomial<Int>& obj);
+    Polynomial(Polynomial<Int>&& obj) noexcept;
     Polynomial(Int* coefficients, const size_t length, bool isDeepCopy = false);
     Polynomial(Int random, Int* inputs, const size_t length);
     ~Polynomial();
 
     Int Evaluate(const Int x) const;
+    template <size_t K> Ext<Int, K> Evaluate(const Ext<Int, K>& x) const; // At a point of an extension field
 
     static Polynomial<Int> LagrangeInterpolation(Int* points, const size_t nPoints);
     static Polynomial<Int> VandermondeInterpolation(Int* points, const size_t nPoints, SquareMatrix<Int>& evalToCoeff);
 
     Polynomial<Int>& operator=(const Polynomial<Int>& op);
-    Polynomial<Int> operator+(const Polynomial<Int>& op);
+    Polynomial<Int>& operator=(Polynomial<Int>&& op) noexcept;
+    Polynomial<Int> operator+(const Polynomial<Int>& op) const;
     void operator+=(const Polynomial<Int>& op);
-    Polynomial<Int> operator-(const Polynomial<Int>& op);
-    Polynomial<Int> operator*(const Polynomial<Int>& op);
+    Polynomial<Int> operator-(const Polynomial<Int>& op) const;
+    void operator-=(const Polynomial<Int>& op);
+    Polynomial<Int> operator*(const Polynomial<Int>& op) const;
+    void MultiplyAdd(const Polynomial<Int>& op0, const Polynomial<Int>& op1); // this += op0 * op1
 
 private:
-    Int* mCoefficients;
-    size_t mCapacity;
+    static constexpr size_t INLINE_CAPACITY = std::max<size_t>(256u / sizeof(Int), 1u); // Up to 256 bytes in place
+    static constexpr size_t NTT_THRESHOLD = 64;             // Product length from which NTT fields use NTTs
+    static constexpr size_t CIRCLE_FFT_THRESHOLD = 384;     // Same for Mpint32 with CircleFft
+    static constexpr size_t QUADRATIC_NTT_THRESHOLD = 7168; // Same for QuadraticNttField, over Karatsuba and Toom-3
+    static constexpr size_t SUBPRODUCT_THRESHOLD = 64;      // Node count from which interpolation is subquadratic
+    static constexpr size_t INTERLEAVED_EVALUATION_THRESHOLD = 256; // Length from which Evaluate splits into chains
+    static constexpr size_t EVALUATION_LANES = 64;                  // Number of those chains
+    static constexpr size_t PARALLEL_EVALUATION_THRESHOLD = 1u << 16; // Length from which chains are split over threads
+
+    Int* mCoefficients; // mInline, or a heap array when mAllocated exceeds INLINE_CAPACITY
+    size_t mCapacity;   // Number of coefficients
+    size_t mAllocated;  // Number of coefficients the storage holds
+    Int mInline[INLINE_CAPACITY];
+
+    void Allocate(const size_t capacity); // Sets the length, reusing the storage when it is large enough
+    void Reserve(const size_t capacity);  // Grows the storage, keeping the coefficients
+    void Release();
+
+    Int EvaluateInterleaved(const Int x) const;
+
+    Polynomial<Int> MultiplyByNtt(const Polynomial<Int>& op, const size_t logSize) const;
+    Polynomial<Int> MultiplyByCircleFft(const Polynomial<Int>& op, const size_t logSize) const;
+    Polynomial<Int> MultiplyByQuadraticNtt(const Polynomial<Int>& op, const size_t logSize) const;
+
+    static Polynomial<Int> SubproductInterpolation(Int* points, const size_t nPoints);
+    static void InterpolateNodes(const Int* weights, const size_t begin, const size_t end, Polynomial<Int>& numerator,
+                                 Polynomial<Int>& nodes);
 };
 
 template <typename Int> Polynomial<Int>::Polynomial()
 {
-    mCoefficients = (Int*)0;
+    mCoefficients = mInline;
     mCapacity = 0;
+    mAllocated = INLINE_CAPACITY;
 }
 
-template <typename Int> Polynomial<Int>::Polynomial(const Polynomial<Int>& obj)
+template <typename Int> Polynomial<Int>::Polynomial(const Polynomial<Int>& obj) : Polynomial()
 {
-    mCoefficients = new Int[obj.mCapacity];
+    Allocate(obj.mCapacity);
     std::memcpy(mCoefficients, obj.mCoefficients, obj.mCapacity * sizeof(Int));
+}
+
+// A heap array changes hands, inline coefficients are copied
+template <typename Int> Polynomial<Int>::Polynomial(Polynomial<Int>&& obj) noexcept : Polynomial()
+{
+    if (obj.mCoefficients == obj.mInline)
+    {
+        std::memcpy(mInline, obj.mInline, obj.mCapacity * sizeof(Int));
+    }
+    else
+    {
+        mCoefficients = obj.mCoefficients;
+        mAllocated = obj.mAllocated;
+        obj.mCoefficients = obj.mInline;
+        obj.mAllocated = INLINE_CAPACITY;
+    }
     mCapacity = obj.mCapacity;
+    obj.mCapacity = 0;
 }
 
-template <typename Int> Polynomial<Int>::Polynomial(Int* coefficients, const size_t capacity, bool isDeepCopy)
+// Without isDeepCopy, the polynomial takes over coefficients, which must come from new[]
+template <typename Int>
+Polynomial<Int>::Polynomial(Int* coefficients, const size_t capacity, bool isDeepCopy) : Polynomial()
 {
     assert(capacity > 0);
     if (isDeepCopy)
     {
-        mCoefficients = new Int[capacity];
+        Allocate(capacity);
         std::memcpy(mCoefficients, coefficients, capacity * sizeof(Int));
-        mCapacity = capacity;
     }
     else
     {
         mCoefficients = coefficients;
         mCapacity = capacity;
+        mAllocated = capacity;
     }
 }
 
-template <typename Int> Polynomial<Int>::Polynomial(Int random, Int* inputs, const size_t length)
+template <typename Int> Polynomial<Int>::Polynomial(Int random, Int* inputs, const size_t length) : Polynomial()
 {
     assert(length > 0);
-    mCapacity = length + 1u;
-    mCoefficients = new Int[mCapacity];
+    Allocate(length + 1u);
     *mCoefficients = random;
     std::memcpy(mCoefficients + 1u, inputs, length * sizeof(Int));
 }
 
 template <typename Int> Polynomial<Int>::~Polynomial()
 {
-    if (mCoefficients != (Int*)0)
-    {
-        delete[] mCoefficients;
-    }
+    Release();
 }
 
 template <typename Int> Int Polynomial<Int>::Evaluate(const Int x) const
 {
-    Int value((uint64_t)0);
+    if (mCapacity >= INTERLEAVED_EVALUATION_THRESHOLD)
+    {
+        return EvaluateInterleaved(x);
+    }
+
+    Accumulator<Int> value;
     Int power((uint64_t)1);
     for (size_t i = 0; i < mCapacity; ++i)
     {
-        value += power * mCoefficients[i];
+        value.MultiplyAdd(power, mCoefficients[i]);
         power *= x;
     }
-    return value;
+    return value.Get();
+}
+
+template <typename Int> template <size_t K> Ext<Int, K> Polynomial<Int>::Evaluate(const Ext<Int, K>& x) const
+{
+    Accumulator<Ext<Int, K>> value;
+    Ext<Int, K> power((uint64_t)1);
+    for (size_t i = 0; i < mCapacity; ++i)
+    {
+        value.MultiplyAdd(power, mCoefficients[i]);
+        power *= x;
+    }
+    return value.Get();
+}
+
+/*
+ * f(x) = sum_r x^r g_r(x^L) for L = EVALUATION_LANES, where g_r takes the coefficients a_r, a_{r+L}, a_{r+2L}, ...
+ * Row j of the coefficients (a_{jL}, ..., a_{jL+L-1}) is added to the L chains times y^j for y = x^L by one Axpy,
+ * so the only serial dependency is one multiplication per row, and the chains are combined by a dot product with
+ * 1, x, ..., x^{L-1}. Long polynomials split their rows over threads, each starting from y^begin, unless operations
+ * are counted (OperationCounter is not shared between threads).
+ */
+template <typename Int> Int Polynomial<Int>::EvaluateInterleaved(const Int x) const
+{
+    const size_t nRows = (mCapacity + EVALUATION_LANES - 1u) / EVALUATION_LANES;
+    size_t nThreads = 1u;
+    if constexpr (!IS_COUNTING_INT<Int>)
+    {
+        if (mCapacity >= PARALLEL_EVALUATION_THRESHOLD)
+        {
+            nThreads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1u,
+                                          mCapacity / (PARALLEL_EVALUATION_THRESHOLD / 2u));
+        }
+    }
+
+    Int powers[EVALUATION_LANES];
+    powers[0] = Int((uint64_t)1);
+    for (size_t r = 1; r < EVALUATION_LANES; ++r)
+    {
+        powers[r] = powers[r - 1] * x;
+    }
+    const Int y = powers[EVALUATION_LANES - 1] * x;
+
+    std::vector<Int> chains(nThreads * EVALUATION_LANES, Int((uint64_t)0));
+    const auto accumulateRows = [&](const size_t t)
+    {
+        const size_t begin = nRows * t / nThreads;
+        const size_t end = nRows * (t + 1u) / nThreads;
+        Int* const chain = chains.data() + t * EVALUATION_LANES;
+        Int power = y.Pow(begin);
+        for (size_t j = begin; j < end; ++j)
+        {
+            const size_t offset = j * EVALUATION_LANES;
+            const size_t length = std::min(EVALUATION_LANES, mCapacity - offset);
+            VectorKernel<Int>::Axpy(chain, power, mCoefficients + offset, length);
+            power *= y;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1u);
+    for (size_t t = 1; t < nThreads; ++t)
+    {
+        threads.emplace_back(accumulateRows, t);
+    }
+    accumulateRows(0);
+    for (size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+    for (size_t t = 1; t < nThreads; ++t)
+    {
+        VectorKernel<Int>::Add(chains.data(), chains.data(), chains.data() + t * EVALUATION_LANES, EVALUATION_LANES);
+    }
+
+    return VectorKernel<Int>::Dot(powers, chains.data(), EVALUATION_LANES);
 }
 
 template <typename Int> Polynomial<Int> Polynomial<Int>::LagrangeInterpolation(Int* points, const size_t nPoints)
 {
     assert(nPoints > 1u);
 
-    Int* coefficients = new Int[nPoints];
-    Int* tempCoefficients = new Int[nPoints];
+    if constexpr (NttField<Int> || QuadraticNttField<Int>)
+    {
+        if (nPoints >= SUBPRODUCT_THRESHOLD)
+        {
+            return SubproductInterpolation(points, nPoints);
+        }
+    }
+
+    // f = sum_i w_i y_i N / (x - i) for N = prod_j (x - j) and the inverted Lagrange denominators w_i from the tables :
+    // N is built once and divided synthetically by every x - i, in O(n^2) without inversions
+    Polynomial<Int> result;
+    result.Allocate(nPoints);
+    Int* const coefficients = result.mCoefficients;
     std::memset(coefficients, 0, nPoints * sizeof(Int));
 
-    for (size_t i = 0; i < nPoints; ++i)
+    // Working arrays stay on the stack for the low degrees that fit inline
+    Int localNodes[INLINE_CAPACITY + 1];
+    Int localQuotient[INLINE_CAPACITY];
+    Int localWeights[INLINE_CAPACITY];
+    const bool isLocal = nPoints <= INLINE_CAPACITY;
+    Int* const nodes = isLocal ? localNodes : new Int[nPoints + 1u]; // N, constant term first
+    Int* const quotient = isLocal ? localQuotient : new Int[nPoints];
+    Int* const weights = isLocal ? localWeights : new Int[nPoints];
+
+    ConstantTables<Int>::CopyLagrangeDenominatorInverses(weights, nPoints);
+    VectorKernel<Int>::Mul(weights, weights, points, nPoints);
+
+    nodes[0] = Int((uint64_t)1);
+    for (size_t j = 0; j < nPoints; ++j)
     {
-        std::memset(tempCoefficients, 0, nPoints * sizeof(Int));
-        tempCoefficients[0] = points[i];
-        Int prod(1u);
+        const Int node(j);
+        nodes[j + 1u] = nodes[j];
+        for (size_t k = j; k > 0u; --k)
+        {
+            nodes[k] = nodes[k - 1u] - node * nodes[k];
+        }
+        nodes[0] = -(node * nodes[0]);
+    }
 
-        for (size_t j = 0; j < nPoints; ++j)
+    const Int zero((uint64_t)0);
+    for (size_t i = 0; i < nPoints; ++i)
+    {
+        // Zero values, such as the padding of a last chunk, add nothing
+        if (weights[i] == zero)
         {
-            if (i == j)
-            {
-                continue;
-            }
-
-            prod *= Int(i) - Int(j);
-            Int precedent((uint64_t)0);
-
-            for (size_t k = 0; k < nPoints; ++k)
-            {
-                Int newres = tempCoefficients[k] * (-Int(j)) + precedent;
-                precedent = tempCoefficients[k];
-                tempCoefficients[k] = newres;
-            }
+            continue;
         }
 
-        prod = prod.Invert();
-        for (size_t j = 0; j < nPoints; j++)
+        // q_{n-1} = N_n and q_{k-1} = N_k + i q_k
+        const Int node(i);
+        quotient[nPoints - 1u] = nodes[nPoints];
+        for (size_t k = nPoints - 1u; k > 0u; --k)
         {
-            coefficients[j] += tempCoefficients[j] * prod;
+            quotient[k - 1u] = nodes[k] + node * quotient[k];
         }
+        VectorKernel<Int>::Axpy(coefficients, weights[i], quotient, nPoints);
     }
 
-    delete[] tempCoefficients;
+    if (!isLocal)
+    {
+        delete[] nodes;
+        delete[] quotient;
+        delete[] weights;
+    }
 
-    return Polynomial(coefficients, nPoints);
+    return result;
 }
 
 template <typename Int>
 Polynomial<Int> Polynomial<Int>::VandermondeInterpolation(Int* points, const size_t nPoints,
                                                           SquareMatrix<Int>& evalToCoeff)
 {
-    Int* const coefficients = new Int[nPoints];
-    std::memset(coefficients, 0, nPoints * sizeof(Int));
+    Polynomial<Int> result;
+    result.Allocate(nPoints);
     for (size_t i = 0; i < nPoints; ++i)
     {
-        for (size_t j = 0; j < nPoints; ++j)
-        {
-            coefficients[i] += points[j] * evalToCoeff.Get(i, j);
-        }
+        result.mCoefficients[i] = VectorKernel<Int>::Dot(evalToCoeff.GetRow(i), points, nPoints);
     }
 
-    return Polynomial<Int>(coefficients, nPoints);
+    return result;
 }
 
 template <typename Int> Polynomial<Int>& Polynomial<Int>::operator=(const Polynomial<Int>& op)
 {
-    if (mCoefficients != (Int*)0)
+    if (this != &op)
     {
-        delete[] mCoefficients;
+        Allocate(op.mCapacity);
+        std::memcpy(mCoefficients, op.mCoefficients, op.mCapacity * sizeof(Int));
     }
 
-    mCoefficients = new Int[op.mCapacity];
-    std::memcpy(mCoefficients, op.mCoefficients, op.mCapacity * sizeof(Int));
-    mCapacity = op.mCapacity;
-
     return *this;
 }
 
-template <typename Int> Polynomial<Int> Polynomial<Int>::operator+(const Polynomial<Int>& op)
+template <typename Int> Polynomial<Int>& Polynomial<Int>::operator=(Polynomial<Int>&& op) noexcept
 {
-    size_t max, min;
-    if (this->mCapacity > op.mCapacity)
+    if (this == &op)
+    {
+        return *this;
+    }
+
+    if (op.mCoefficients == op.mInline)
     {
-        max = this->mCapacity;
-        min = op.mCapacity;
+        Allocate(op.mCapacity);
+        std::memcpy(mCoefficients, op.mInline, op.mCapacity * sizeof(Int));
     }
     else
     {
-        max = op.mCapacity;
-        min = this->mCapacity;
+        Release();
+        mCoefficients = op.mCoefficients;
+        mCapacity = op.mCapacity;
+        mAllocated = op.mAllocated;
+        op.mCoefficients = op.mInline;
+        op.mAllocated = INLINE_CAPACITY;
     }
+    op.mCapacity = 0;
+
+    return *this;
+}
+
+template <typename Int> Polynomial<Int> Polynomial<Int>::operator+(const Polynomial<Int>& op) const
+{
+    const Polynomial<Int>& longer = mCapacity >= op.mCapacity ? *this : op;
+    const size_t min = std::min(mCapacity, op.mCapacity);
+
+    Polynomial<Int> result;
+    result.Allocate(longer.mCapacity);
+    VectorKernel<Int>::Add(result.mCoefficients, mCoefficients, op.mCoefficients, min);
+    std::memcpy(result.mCoefficients + min, longer.mCoefficients + min, (longer.mCapacity - min) * sizeof(Int));
 
-    Int* coefficients = new Int[max];
-    for (size_t i = 0; i < min; ++i)
+    return result;
+}
+
+// In place whenever the storage already holds the longer operand
+template <typename Int> void Polynomial<Int>::operator+=(const Polynomial& op)
+{
+    const size_t min = std::min(mCapacity, op.mCapacity);
+    Reserve(op.mCapacity);
+    VectorKernel<Int>::Add(mCoefficients, mCoefficients, op.mCoefficients, min);
+    if (op.mCapacity > mCapacity)
     {
-        coefficients[i] = this->mCoefficients[i] + op.mCoefficients[i];
+        std::memcpy(mCoefficients + min, op.mCoefficients + min, (op.mCapacity - min) * sizeof(Int));
+        mCapacity = op.mCapacity;
     }
-    if (this->mCapacity > op.mCapacity)
+}
+
+template <typename Int> Polynomial<Int> Polynomial<Int>::operator-(const Polynomial& op) const
+{
+    const size_t min = std::min(mCapacity, op.mCapacity);
+
+    Polynomial<Int> result;
+    result.Allocate(std::max(mCapacity, op.mCapacity));
+    VectorKernel<Int>::Sub(result.mCoefficients, mCoefficients, op.mCoefficients, min);
+    std::memcpy(result.mCoefficients + min, mCoefficients + min, (mCapacity - min) * sizeof(Int));
+    for (size_t i = min; i < op.mCapacity; ++i)
     {
-        std::memcpy(coefficients + min, this->mCoefficients + min, (max - min) * sizeof(Int));
+        result.mCoefficients[i] = -op.mCoefficients[i];
     }
-    else
+
+    return result;
+}
+
+template <typename Int> void Polynomial<Int>::operator-=(const Polynomial& op)
+{
+    const size_t min = std::min(mCapacity, op.mCapacity);
+    Reserve(op.mCapacity);
+    VectorKernel<Int>::Sub(mCoefficients, mCoefficients, op.mCoefficients, min);
+    for (size_t i = min; i < op.mCapacity; ++i)
     {
-        std::memcpy(coefficients + min, op.mCoefficients + min, (max - min) * sizeof(Int));
+        mCoefficients[i] = -op.mCoefficients[i];
     }
-
-    return Polynomial(coefficients, max);
+    mCapacity = std::max(mCapacity, op.mCapacity);
 }
 
-template <typename Int> void Polynomial<Int>::operator+=(const Polynomial& op)
+template <typename Int> Polynomial<Int> Polynomial<Int>::operator*(const Polynomial<Int>& op) const
 {
-    size_t max, min;
-    if (this->mCapacity > op.mCapacity)
+    const size_t capacity = mCapacity + op.mCapacity - 1;
+
+    size_t logSize = 0u;
+    while (((size_t)1 << logSize) < capacity)
     {
-        max = this->mCapacity;
-        min = op.mCapacity;
+        ++logSize;
     }
-    else
+    if constexpr (NttField<Int>)
     {
-        max = op.mCapacity;
-        min = this->mCapacity;
+        if (capacity >= NTT_THRESHOLD && logSize <= Int::GetTwoAdicity() && logSize <= Ntt<Int>::MAX_LOG_SIZE)
+        {
+            return MultiplyByNtt(op, logSize);
+        }
     }
-
-    Int* coefficients = new Int[max];
-    for (size_t i = 0; i < min; ++i)
+    else if constexpr (std::is_same_v<Int, Mpint32>)
     {
-        coefficients[i] = this->mCoefficients[i] + op.mCoefficients[i];
+        if (capacity >= CIRCLE_FFT_THRESHOLD && logSize <= CircleFft::MAX_LOG_SIZE)
+        {
+            return MultiplyByCircleFft(op, logSize);
+        }
     }
-    if (this->mCapacity > op.mCapacity)
+    else if constexpr (QuadraticNttField<Int>)
     {
-        std::memcpy(coefficients + min, this->mCoefficients + min, (max - min) * sizeof(Int));
+        if (capacity >= QUADRATIC_NTT_THRESHOLD && logSize <= Ext<Int, 2>::GetTwoAdicity() &&
+            logSize <= Ntt<Ext<Int, 2>>::MAX_LOG_SIZE)
+        {
+            return MultiplyByQuadraticNtt(op, logSize);
+        }
     }
-    else
+
+    // Schoolbook, Karatsuba or Toom-3 by length, in one scratch buffer for the whole recursion
+    Polynomial<Int> result;
+    result.Allocate(capacity);
+    const size_t scratchLength = PolynomialMultiplier<Int>::GetScratchLength(mCapacity, op.mCapacity);
+    Int* const scratch = scratchLength > 0u ? new Int[scratchLength] : (Int*)0;
+    PolynomialMultiplier<Int>::Multiply(result.mCoefficients, mCoefficients, mCapacity, op.mCoefficients,
+                                        op.mCapacity, scratch);
+    if (scratch != (Int*)0)
     {
-        std::memcpy(coefficients + min, op.mCoefficients + min, (max - min) * sizeof(Int));
+        delete[] scratch;
     }
 
-    delete[] mCoefficients;
-    mCoefficients = coefficients;
-    mCapacity = max;
+    return result;
 }
 
-template <typename Int> Polynomial<Int> Polynomial<Int>::operator-(const Polynomial& op)
+// Below the Karatsuba threshold the product is accumulated straight into the coefficients, without a temporary
+template <typename Int> void Polynomial<Int>::MultiplyAdd(const Polynomial<Int>& op0, const Polynomial<Int>& op1)
 {
-    size_t max, min;
-    if (this->mCapacity > op.mCapacity)
+    assert(op0.mCapacity > 0u && op1.mCapacity > 0u);
+    assert(this != &op0 && this != &op1);
+
+    if (std::min(op0.mCapacity, op1.mCapacity) >= PolynomialMultiplier<Int>::KARATSUBA_THRESHOLD)
     {
-        max = this->mCapacity;
-        min = op.mCapacity;
+        *this += op0 * op1;
+        return;
     }
-    else
+
+    const size_t capacity = op0.mCapacity + op1.mCapacity - 1u;
+    if (capacity > mCapacity)
     {
-        max = op.mCapacity;
-        min = this->mCapacity;
+        Reserve(capacity);
+        std::fill(mCoefficients + mCapacity, mCoefficients + capacity, Int((uint64_t)0));
+        mCapacity = capacity;
     }
+    for (size_t k = 0; k < capacity; ++k)
+    {
+        const size_t begin = k < op1.mCapacity ? 0 : k - op1.mCapacity + 1;
+        const size_t end = std::min(k + 1, op0.mCapacity);
+
+        Accumulator<Int> coefficient;
+        coefficient.Add(mCoefficients[k]);
+        for (size_t i = begin; i < end; ++i)
+        {
+            coefficient.MultiplyAdd(op0.mCoefficients[i], op1.mCoefficients[k - i]);
+        }
+        mCoefficients[k] = coefficient.Get();
+    }
+}
 
-    Int* coefficients = new Int[max];
-    for (size_t i = 0; i < min; ++i)
+template <typename Int> void Polynomial<Int>::Allocate(const size_t capacity)
+{
+    if (capacity > mAllocated)
     {
-        coefficients[i] = this->mCoefficients[i] - op.mCoefficients[i];
+        Release();
+        mCoefficients = new Int[capacity];
+        mAllocated = capacity;
     }
-    if (this->mCapacity > op.mCapacity)
+    mCapacity = capacity;
+}
+
+template <typename Int> void Polynomial<Int>::Reserve(const size_t capacity)
+{
+    if (capacity <= mAllocated)
     {
-        std::memcpy(coefficients + min, this->mCoefficients + min, (max - min) * sizeof(Int));
+        return;
     }
-    else
+
+    Int* const coefficients = new Int[capacity];
+    std::memcpy(coefficients, mCoefficients, mCapacity * sizeof(Int));
+    Release();
+    mCoefficients = coefficients;
+    mAllocated = capacity;
+}
+
+template <typename Int> void Polynomial<Int>::Release()
+{
+    if (mCoefficients != mInline)
     {
-        std::memcpy(coefficients + min, op.mCoefficients + min, (max - min) * sizeof(Int));
+        delete[] mCoefficients;
+        mCoefficients = mInline;
+        mAllocated = INLINE_CAPACITY;
     }
+}
 
-    return Polynomial(coefficients, max);
+// Pointwise product of the transforms : the transform is cyclic, so 2^logSize must cover the whole product
+template <typename Int>
+Polynomial<Int> Polynomial<Int>::MultiplyByNtt(const Polynomial<Int>& op, const size_t logSize) const
+{
+    const Ntt<Int>& ntt = Ntt<Int>::GetInstance(logSize);
+    const size_t size = ntt.GetSize();
+
+    Int* const coefficients = new Int[size];
+    Int* const opCoefficients = new Int[size];
+    std::memset(coefficients, 0, size * sizeof(Int));
+    std::memset(opCoefficients, 0, size * sizeof(Int));
+    std::memcpy(coefficients, mCoefficients, mCapacity * sizeof(Int));
+    std::memcpy(opCoefficients, op.mCoefficients, op.mCapacity * sizeof(Int));
+
+    ntt.Forward(coefficients);
+    ntt.Forward(opCoefficients);
+    VectorKernel<Int>::Mul(coefficients, coefficients, opCoefficients, size);
+    ntt.Inverse(coefficients);
+
+    delete[] opCoefficients;
+
+    return Polynomial(coefficients, mCapacity + op.mCapacity - 1);
 }
 
-template <typename Int> Polynomial<Int> Polynomial<Int>::operator*(const Polynomial<Int>& op)
+/*
+ * The same packing as MultiplyByQuadraticNtt with the real and imaginary parts in separate arrays.
+ * Forward leaves C_k at the bit reversal of k : for k of lowest set bit 2^(logSize - 1 - b), -k keeps that bit and
+ * flips the ones above it, so positions m + j and 2m - 1 - j with m = 2^b hold C_k and C_-k.
+ */
+template <typename Int>
+Polynomial<Int> Polynomial<Int>::MultiplyByCircleFft(const Polynomial<Int>& op, const size_t logSize) const
 {
-    const size_t capacity = mCapacity + op.mCapacity - 1;
+    const CircleFft& fft = CircleFft::GetInstance(logSize);
+    const size_t size = fft.GetSize();
+
+    Int* const real = new Int[size];
+    Int* const imaginary = new Int[size];
+    std::memset(real, 0, size * sizeof(Int));
+    std::memset(imaginary, 0, size * sizeof(Int));
+    std::memcpy(real, mCoefficients, mCapacity * sizeof(Int));
+    std::memcpy(imaginary, op.mCoefficients, op.mCapacity * sizeof(Int));
+
+    fft.Forward(real, imaginary);
+
+    const Int quarter = ConstantTables<Int>::GetInverse(4);
+    const Int half = ConstantTables<Int>::GetInverse(2);
+    real[0] = real[0] * imaginary[0];
+    imaginary[0] = Int((uint64_t)0);
+    for (size_t m = 1u; m < size; m <<= 1)
+    {
+        for (size_t j = 0; j < (m + 1u) / 2u; ++j)
+        {
+            const size_t position = m + j;
+            const size_t negatedPosition = 2u * m - 1u - j;
+
+            // Squares of C_k = a + ib and C_-k = c + id
+            const Int a = real[position];
+            const Int b = imaginary[position];
+            const Int c = real[negatedPosition];
+            const Int d = imaginary[negatedPosition];
+            const Int squareReal = (a + b) * (a - b);
+            const Int negatedSquareReal = (c + d) * (c - d);
+            const Int squareImaginary = a * b;
+            const Int negatedSquareImaginary = c * d;
+
+            const Int productReal = (squareImaginary + negatedSquareImaginary) * half;
+            const Int productImaginary = (negatedSquareReal - squareReal) * quarter;
+            real[position] = productReal;
+            imaginary[position] = productImaginary;
+            real[negatedPosition] = productReal;
+            imaginary[negatedPosition] = -productImaginary;
+        }
+    }
 
-    Int* coefficients = new Int[capacity];
-    std::memset(coefficients, 0, capacity * sizeof(Int));
-    for (size_t i = 0; i < mCapacity; ++i)
+    fft.Inverse(real, imaginary);
+
+    delete[] imaginary;
+
+    return Polynomial(real, mCapacity + op.mCapacity - 1);
+}
+
+/*
+ * Both operands go into one transform over Ext<Int, 2> as c = a + i b. Roots of unity w of order dividing p + 1 have
+ * conj(w) = w^-1, so A(w^k) = (C_k + conj(C_-k)) / 2 and B(w^k) = (C_k - conj(C_-k)) / 2i as over the complex numbers,
+ * and the product A B = (C_k^2 - conj(C_-k)^2) / 4i comes back real from a single inverse transform.
+ */
+template <typename Int>
+Polynomial<Int> Polynomial<Int>::MultiplyByQuadraticNtt(const Polynomial<Int>& op, const size_t logSize) const
+{
+    const Ntt<Ext<Int, 2>>& ntt = Ntt<Ext<Int, 2>>::GetInstance(logSize);
+    const size_t size = ntt.GetSize();
+
+    Ext<Int, 2>* const values = new Ext<Int, 2>[size];
+    Int* const parts = (Int*)values; // Real and imaginary part of every value in turn
+    for (size_t k = 0; k < size; ++k)
+    {
+        parts[2u * k] = k < mCapacity ? mCoefficients[k] : Int((uint64_t)0);
+        parts[2u * k + 1u] = k < op.mCapacity ? op.mCoefficients[k] : Int((uint64_t)0);
+    }
+
+    ntt.Forward(values);
+
+    // Forward leaves C_k at the bit reversal of k, so k and -k are visited in natural order as pairs
+    const Int quarter = ConstantTables<Int>::GetInverse(4);
+    for (size_t k = 0; k <= size / 2u; ++k)
     {
-        for (size_t j = 0; j < op.mCapacity; ++j)
+        const size_t negated = (size - k) & (size - 1u);
+        size_t position = 0u;
+        size_t negatedPosition = 0u;
+        for (size_t bit = 0; bit < logSize; ++bit)
         {
-            coefficients[i + j] += mCoefficients[i] * op.mCoefficients[j];
+            position |= ((k >> bit) & 1u) << (logSize - 1u - bit);
+            negatedPosition |= ((negated >> bit) & 1u) << (logSize - 1u - bit);
         }
+
+        const Ext<Int, 2> square = values[position] * values[position];
+        const Ext<Int, 2> negatedSquare = values[negatedPosition] * values[negatedPosition];
+        const Int real = (square.GetCoefficient(1) + negatedSquare.GetCoefficient(1)) * quarter;
+        const Int imaginary = (negatedSquare.GetCoefficient(0) - square.GetCoefficient(0)) * quarter;
+        parts[2u * position] = real;
+        parts[2u * position + 1u] = imaginary;
+        parts[2u * negatedPosition] = real;
+        parts[2u * negatedPosition + 1u] = -imaginary;
     }
 
+    ntt.Inverse(values);
+
+    const size_t capacity = mCapacity + op.mCapacity - 1;
+    Int* const coefficients = new Int[capacity];
+    for (size_t k = 0; k < capacity; ++k)
+    {
+        coefficients[k] = parts[2u * k];
+    }
+    delete[] values;
+
     return Polynomial(coefficients, capacity);
 }
 
+/*
+ * f = sum_i w_i y_i prod_{j != i} (x - j) for the Lagrange denominators w_i, summed over a binary tree of node ranges :
+ * a range keeps its node polynomial prod (x - j) and its numerator, and two ranges combine with fast products,
+ * in O(M(n) log n) for the multiplication time M(n) of operator*.
+ */
+template <typename Int> Polynomial<Int> Polynomial<Int>::SubproductInterpolation(Int* points, const size_t nPoints)
+{
+    Int* const weights = new Int[nPoints];
+    ConstantTables<Int>::CopyLagrangeDenominatorInverses(weights, nPoints);
+    VectorKernel<Int>::Mul(weights, weights, points, nPoints);
+
+    Polynomial<Int> numerator;
+    Polynomial<Int> nodes;
+    InterpolateNodes(weights, 0, nPoints, numerator, nodes);
+
+    delete[] weights;
+
+    return numerator;
+}
+
+template <typename Int>
+void Polynomial<Int>::InterpolateNodes(const Int* weights, const size_t begin, const size_t end,
+                                       Polynomial<Int>& numerator, Polynomial<Int>& nodes)
+{
+    if (end - begin == 1u)
+    {
+        nodes.Allocate(2);
+        nodes.mCoefficients[0] = -Int(begin);
+        nodes.mCoefficients[1] = Int((uint64_t)1);
+        numerator.Allocate(1);
+        numerator.mCoefficients[0] = weights[begin];
+        return;
+    }
+
+    const size_t middle = begin + (end - begin) / 2u;
+    Polynomial<Int> leftNumerator, leftNodes, rightNumerator, rightNodes;
+    InterpolateNodes(weights, begin, middle, leftNumerator, leftNodes);
+    InterpolateNodes(weights, middle, end, rightNumerator, rightNodes);
+
+    numerator = leftNumerator * rightNodes;
+    numerator.MultiplyAdd(rightNumerator, leftNodes);
+    nodes = leftNodes * rightNodes;
+}
+
 #endif
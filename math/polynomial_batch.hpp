@@ -0,0 +1,78 @@
+#ifndef POLYNOMIAL_BATCH_H
+#define POLYNOMIAL_BATCH_H
+
+#include <algorithm>
+#include <vector>
+
+#include "../math/polynomial.hpp"
+#include "../math/vector_kernel.hpp"
+
+/*
+ * Polynomials of one proof round as a single coefficient matrix stored by columns : coefficient j of every polynomial
+ * is contiguous, shorter polynomials being zero-padded. Evaluating all of them at x takes the powers of x once and one
+ * Axpy per power over the whole column, instead of a Horner loop per polynomial on its own heap buffer.
+ */
+template <typename Int> class PolynomialBatch
+{
+public:
+    PolynomialBatch();
+    PolynomialBatch(const std::vector<Polynomial<Int>>& polys);
+
+    size_t GetCount() const;
+    std::vector<Int> Evaluate(const Int x) const; // f_0(x), ..., f_{count-1}(x)
+
+private:
+    std::vector<Int> mCoefficients; // mLength columns of mCount coefficients
+    size_t mCount;
+    size_t mLength;
+};
+
+template <typename Int> PolynomialBatch<Int>::PolynomialBatch()
+{
+    mCount = 0u;
+    mLength = 0u;
+}
+
+template <typename Int> PolynomialBatch<Int>::PolynomialBatch(const std::vector<Polynomial<Int>>& polys)
+{
+    mCount = polys.size();
+    mLength = 0u;
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        mLength = std::max(mLength, polys[i].mCapacity);
+    }
+
+    mCoefficients.assign(mCount * mLength, Int((uint64_t)0));
+    for (size_t i = 0; i < mCount; ++i)
+    {
+        const Int* const coefficients = polys[i].mCoefficients;
+        for (size_t j = 0; j < polys[i].mCapacity; ++j)
+        {
+            mCoefficients[j * mCount + i] = coefficients[j];
+        }
+    }
+}
+
+template <typename Int> size_t PolynomialBatch<Int>::GetCount() const
+{
+    return mCount;
+}
+
+template <typename Int> std::vector<Int> PolynomialBatch<Int>::Evaluate(const Int x) const
+{
+    if (mLength == 0u)
+    {
+        return std::vector<Int>(mCount, Int((uint64_t)0));
+    }
+
+    std::vector<Int> results(mCoefficients.begin(), mCoefficients.begin() + mCount);
+    Int power = x;
+    for (size_t j = 1; j < mLength; ++j)
+    {
+        VectorKernel<Int>::Axpy(results.data(), power, mCoefficients.data() + j * mCount, mCount);
+        power *= x;
+    }
+    return results;
+}
+
+#endif
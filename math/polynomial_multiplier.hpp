@@ -0,0 +1,264 @@
+#ifndef POLYNOMIAL_MULTIPLIER_H
+#define POLYNOMIAL_MULTIPLIER_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "../math/accumulator.hpp"
+#include "../math/constant_tables.hpp"
+#include "../math/vector_kernel.hpp"
+
+/*
+ * Product of coefficient arrays by schoolbook, Karatsuba or Toom-3, switching on the operand length at every level.
+ * Recursion works in scratch memory given by the caller (GetScratchLength), so it never allocates.
+ * Toom-3 divides by 2 and 3 and needs IntegerNodes fields, other fields stop at Karatsuba.
+ */
+template <typename Int> class PolynomialMultiplier
+{
+public:
+    // Chosen from PerformanceMeasurement::ComparePolynomialMultiplication
+    static constexpr size_t KARATSUBA_THRESHOLD = 32; // Balanced length from which Karatsuba is used
+    static constexpr size_t TOOM3_THRESHOLD = 128;    // Balanced length from which Toom-3 is used
+
+    static size_t GetScratchLength(const size_t length0, const size_t length1);
+
+    // dst takes length0 + length1 - 1 coefficients and overlaps neither the operands nor the scratch
+    static void Multiply(Int* dst, const Int* op0, const size_t length0, const Int* op1, const size_t length1,
+                         Int* scratch);
+    static void MultiplySchoolbook(Int* dst, const Int* op0, const size_t length0, const Int* op1,
+                                   const size_t length1);
+    static void MultiplyKaratsuba(Int* dst, const Int* op0, const Int* op1, const size_t length, Int* scratch);
+    static void MultiplyToom3(Int* dst, const Int* op0, const Int* op1, const size_t length, Int* scratch);
+
+private:
+    static constexpr bool HAS_TOOM3 = IntegerNodes<typename TableField<Int>::Type>;
+
+    static size_t GetBalancedScratchLength(const size_t length);
+    static void MultiplyBalanced(Int* dst, const Int* op0, const Int* op1, const size_t length, Int* scratch);
+};
+
+template <typename Int> size_t PolynomialMultiplier<Int>::GetScratchLength(const size_t length0, const size_t length1)
+{
+    const size_t shorter = std::min(length0, length1);
+    if (shorter < KARATSUBA_THRESHOLD)
+    {
+        return 0u;
+    }
+    if (shorter == std::max(length0, length1))
+    {
+        return GetBalancedScratchLength(shorter);
+    }
+    return 3u * shorter - 1u + GetBalancedScratchLength(shorter);
+}
+
+// The longer operand is cut into blocks of the shorter length (the last one zero-padded), whose products are added up
+template <typename Int>
+void PolynomialMultiplier<Int>::Multiply(Int* dst, const Int* op0, const size_t length0, const Int* op1,
+                                         const size_t length1, Int* scratch)
+{
+    assert(length0 > 0u && length1 > 0u);
+
+    if (length0 < length1)
+    {
+        Multiply(dst, op1, length1, op0, length0, scratch);
+        return;
+    }
+    if (length1 < KARATSUBA_THRESHOLD)
+    {
+        MultiplySchoolbook(dst, op0, length0, op1, length1);
+        return;
+    }
+    if (length0 == length1)
+    {
+        MultiplyBalanced(dst, op0, op1, length0, scratch);
+        return;
+    }
+
+    std::fill(dst, dst + length0 + length1 - 1u, Int((uint64_t)0));
+    Int* const product = scratch;
+    Int* const padded = product + 2u * length1 - 1u;
+    Int* const nextScratch = padded + length1;
+    for (size_t offset = 0; offset < length0; offset += length1)
+    {
+        const size_t blockLength = std::min(length1, length0 - offset);
+        const Int* block = op0 + offset;
+        if (blockLength < length1)
+        {
+            std::memcpy(padded, block, blockLength * sizeof(Int));
+            std::fill(padded + blockLength, padded + length1, Int((uint64_t)0));
+            block = padded;
+        }
+        MultiplyBalanced(product, block, op1, length1, nextScratch);
+        VectorKernel<Int>::Add(dst + offset, dst + offset, product, blockLength + length1 - 1u);
+    }
+}
+
+// Each output coefficient is a dot product, so it is accumulated once and reduced once
+template <typename Int>
+void PolynomialMultiplier<Int>::MultiplySchoolbook(Int* dst, const Int* op0, const size_t length0, const Int* op1,
+                                                   const size_t length1)
+{
+    const size_t capacity = length0 + length1 - 1u;
+    for (size_t k = 0; k < capacity; ++k)
+    {
+        const size_t begin = k < length1 ? 0 : k - length1 + 1;
+        const size_t end = std::min(k + 1, length0);
+
+        Accumulator<Int> coefficient;
+        for (size_t i = begin; i < end; ++i)
+        {
+            coefficient.MultiplyAdd(op0[i], op1[k - i]);
+        }
+        dst[k] = coefficient.Get();
+    }
+}
+
+// (a0 + a1 x^h)(b0 + b1 x^h) = a0 b0 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) x^h + a1 b1 x^2h
+template <typename Int>
+void PolynomialMultiplier<Int>::MultiplyKaratsuba(Int* dst, const Int* op0, const Int* op1, const size_t length,
+                                                  Int* scratch)
+{
+    const size_t half = (length + 1u) / 2u;
+    const size_t rest = length - half;
+
+    MultiplyBalanced(dst, op0, op1, half, scratch);
+    dst[2u * half - 1u] = Int((uint64_t)0);
+    MultiplyBalanced(dst + 2u * half, op0 + half, op1 + half, rest, scratch);
+
+    Int* const sum0 = scratch;
+    Int* const sum1 = sum0 + half;
+    Int* const middle = sum1 + half;
+    Int* const nextScratch = middle + 2u * half - 1u;
+
+    VectorKernel<Int>::Add(sum0, op0, op0 + half, rest);
+    VectorKernel<Int>::Add(sum1, op1, op1 + half, rest);
+    if (rest < half)
+    {
+        sum0[rest] = op0[rest];
+        sum1[rest] = op1[rest];
+    }
+    MultiplyBalanced(middle, sum0, sum1, half, nextScratch);
+
+    VectorKernel<Int>::Sub(middle, middle, dst, 2u * half - 1u);
+    VectorKernel<Int>::Sub(middle, middle, dst + 2u * half, 2u * rest - 1u);
+    VectorKernel<Int>::Add(dst + half, dst + half, middle, 2u * half - 1u);
+}
+
+/*
+ * Evaluation at 0, 1, -1, -2 and infinity, and Bodrato's interpolation sequence :
+ * r3 = (r(-2) - r(1)) / 3, r1 = (r(1) - r(-1)) / 2, r2 = r(-1) - r(0),
+ * r3 = (r2 - r3) / 2 + 2 r(inf), r2 = r2 + r1 - r(inf), r1 = r1 - r3
+ */
+template <typename Int>
+void PolynomialMultiplier<Int>::MultiplyToom3(Int* dst, const Int* op0, const Int* op1, const size_t length,
+                                              Int* scratch)
+{
+    static_assert(HAS_TOOM3);
+
+    const size_t third = (length + 2u) / 3u;
+    const size_t rest = length - 2u * third;
+    const size_t productLength = 2u * third - 1u;
+    const size_t restProductLength = 2u * rest - 1u;
+
+    Int* const evaluations = scratch; // p(1), p(-1), p(-2) of op0 and then of op1
+    Int* const atOne = evaluations + 6u * third;
+    Int* const atMinusOne = atOne + productLength;
+    Int* const atMinusTwo = atMinusOne + productLength;
+    Int* const nextScratch = atMinusTwo + productLength;
+
+    const Int* const operands[2] = {op0, op1};
+    for (size_t j = 0; j < 2; ++j)
+    {
+        const Int* const low = operands[j];
+        const Int* const middle = low + third;
+        const Int* const high = middle + third;
+        Int* const one = evaluations + 3u * j * third;
+        Int* const minusOne = one + third;
+        Int* const minusTwo = minusOne + third;
+
+        // p(-2) = 2 (p(-1) + a2) - a0, with a2 zero-padded to the length of a third
+        VectorKernel<Int>::Add(one, low, high, rest);
+        std::memcpy(one + rest, low + rest, (third - rest) * sizeof(Int));
+        VectorKernel<Int>::Sub(minusOne, one, middle, third);
+        VectorKernel<Int>::Add(one, one, middle, third);
+        VectorKernel<Int>::Add(minusTwo, minusOne, high, rest);
+        std::memcpy(minusTwo + rest, minusOne + rest, (third - rest) * sizeof(Int));
+        VectorKernel<Int>::Add(minusTwo, minusTwo, minusTwo, third);
+        VectorKernel<Int>::Sub(minusTwo, minusTwo, low, third);
+    }
+
+    Int* const r0 = dst;
+    Int* const rInfinity = dst + 4u * third;
+    MultiplyBalanced(r0, op0, op1, third, nextScratch);
+    MultiplyBalanced(rInfinity, op0 + 2u * third, op1 + 2u * third, rest, nextScratch);
+    MultiplyBalanced(atOne, evaluations, evaluations + 3u * third, third, nextScratch);
+    MultiplyBalanced(atMinusOne, evaluations + third, evaluations + 4u * third, third, nextScratch);
+    MultiplyBalanced(atMinusTwo, evaluations + 2u * third, evaluations + 5u * third, third, nextScratch);
+
+    const Int halfInverse = ConstantTables<Int>::GetInverse(2);
+    const Int thirdInverse = ConstantTables<Int>::GetInverse(3);
+    Int* const r1 = atOne;
+    Int* const r2 = atMinusOne;
+    Int* const r3 = atMinusTwo;
+
+    VectorKernel<Int>::Sub(r3, atMinusTwo, atOne, productLength);
+    VectorKernel<Int>::Scale(r3, r3, thirdInverse, productLength);
+    VectorKernel<Int>::Sub(r1, atOne, atMinusOne, productLength);
+    VectorKernel<Int>::Scale(r1, r1, halfInverse, productLength);
+    VectorKernel<Int>::Sub(r2, atMinusOne, r0, productLength);
+    VectorKernel<Int>::Sub(r3, r2, r3, productLength);
+    VectorKernel<Int>::Scale(r3, r3, halfInverse, productLength);
+    VectorKernel<Int>::Axpy(r3, Int((uint64_t)2), rInfinity, restProductLength);
+    VectorKernel<Int>::Add(r2, r2, r1, productLength);
+    VectorKernel<Int>::Sub(r2, r2, rInfinity, restProductLength);
+    VectorKernel<Int>::Sub(r1, r1, r3, productLength);
+
+    // r(0) and r(inf) are in place, and the gap between them is filled before r1, r2, r3 are added at k, 2k, 3k
+    std::fill(dst + productLength, rInfinity, Int((uint64_t)0));
+    VectorKernel<Int>::Add(dst + third, dst + third, r1, productLength);
+    VectorKernel<Int>::Add(dst + 2u * third, dst + 2u * third, r2, productLength);
+    VectorKernel<Int>::Add(dst + 3u * third, dst + 3u * third, r3, productLength);
+}
+
+template <typename Int> size_t PolynomialMultiplier<Int>::GetBalancedScratchLength(const size_t length)
+{
+    if (length < KARATSUBA_THRESHOLD)
+    {
+        return 0u;
+    }
+    if (HAS_TOOM3 && length >= TOOM3_THRESHOLD)
+    {
+        const size_t third = (length + 2u) / 3u;
+        return 6u * third + 3u * (2u * third - 1u) + GetBalancedScratchLength(third);
+    }
+    const size_t half = (length + 1u) / 2u;
+    return 4u * half - 1u + GetBalancedScratchLength(half);
+}
+
+template <typename Int>
+void PolynomialMultiplier<Int>::MultiplyBalanced(Int* dst, const Int* op0, const Int* op1, const size_t length,
+                                                 Int* scratch)
+{
+    if (length < KARATSUBA_THRESHOLD)
+    {
+        MultiplySchoolbook(dst, op0, length, op1, length);
+    }
+    else if constexpr (HAS_TOOM3)
+    {
+        if (length >= TOOM3_THRESHOLD)
+        {
+            MultiplyToom3(dst, op0, op1, length, scratch);
+        }
+        else
+        {
+            MultiplyKaratsuba(dst, op0, op1, length, scratch);
+        }
+    }
+    else
+    {
+        MultiplyKaratsuba(dst, op0, op1, length, scratch);
+    }
+}
+
+#endif
@@ -0,0 +1,475 @@
+#ifndef PRIME_FIELD_H
+#define PRIME_FIELD_H
+
+#include <cassert>
+#include <concepts>
+#include <cstring>
+#include <span>
+#include <stdint.h>
+
+#include "../math/chacha_prg.hpp"
+
+/*
+ * Integer over a prime field Z_P for any odd prime P < 2^64, kept in Montgomery form (x * 2^64 mod P).
+ * Goldilocks (2^64 - 2^32 + 1) is kept in canonical form instead and reduced with 2^64 = 2^32 - 1 (mod P).
+ * Both expose a primitive 2^k-th root of unity for every k up to the two-adicity of P - 1 (see ntt.hpp).
+ */
+template <uint64_t P> class PrimeField
+{
+public:
+    constexpr PrimeField();
+    template <std::integral T> constexpr PrimeField(T value);
+    PrimeField(unsigned char* addr);
+
+    static constexpr uint64_t GetBase();
+    static uint32_t GetSeed();
+    constexpr uint64_t GetValue() const;
+
+    static void SetSeed(uint32_t seed);
+
+    static PrimeField GenerateRandom();
+    static PrimeField GenerateRandomAbove(uint64_t min);
+    static void FillRandom(PrimeField* values, const size_t length);
+    static void Reverse(PrimeField* begin, PrimeField* end);
+    static void BatchInvert(std::span<PrimeField> values);
+    static void Canonicalize(PrimeField* values, const size_t length);
+
+    static constexpr size_t GetTwoAdicity();
+    static constexpr PrimeField GetRootOfUnity(size_t logOrder);
+
+    constexpr PrimeField Invert() const;
+    constexpr PrimeField Pow(uint64_t exp) const;
+
+    constexpr PrimeField operator+(const PrimeField& op) const;
+    constexpr PrimeField& operator+=(const PrimeField& op);
+    constexpr PrimeField operator-(const PrimeField& op) const;
+    constexpr PrimeField& operator-=(const PrimeField& op);
+    constexpr PrimeField operator-() const;
+    constexpr PrimeField operator*(const PrimeField& op) const;
+    constexpr PrimeField& operator*=(const PrimeField& op);
+    constexpr PrimeField operator/(const PrimeField& op) const;
+    constexpr PrimeField& operator/=(const PrimeField& op);
+    constexpr bool operator==(const PrimeField& op) const;
+    constexpr bool operator>(const PrimeField& op) const;
+    constexpr bool operator<(const PrimeField& op) const;
+    constexpr bool operator>=(const PrimeField& op) const;
+    constexpr bool operator<=(const PrimeField& op) const;
+    constexpr bool operator!=(const PrimeField& op) const;
+
+private:
+    static_assert(P % 2u == 1u && P > 2u, "P must be an odd prime");
+
+    static constexpr uint64_t BASE = P;
+    static constexpr bool IS_GOLDILOCKS = P == 0xFFFFFFFF00000001;
+    static constexpr uint64_t EPSILON = 0xFFFFFFFF; // 2^64 mod Goldilocks
+    static uint32_t sSeed;                          // Random seed
+
+    uint64_t mValue;
+
+    static constexpr uint64_t ComputeMontgomeryFactor();
+    static constexpr uint64_t ComputeRSquared();
+    static constexpr uint64_t ComputeRandomMask();
+
+    static constexpr uint64_t M_FACTOR = ComputeMontgomeryFactor(); // -P^-1 mod 2^64
+    static constexpr uint64_t R_SQUARED = ComputeRSquared();        // 2^128 mod P
+    static constexpr uint64_t RANDOM_MASK = ComputeRandomMask();    // 2^(bit length of P) - 1
+
+    static constexpr uint64_t MultiplyWide(uint64_t x, uint64_t y, uint64_t& high);
+    static constexpr uint64_t Reduce(uint64_t low, uint64_t high);
+    static constexpr uint64_t Multiply(uint64_t x, uint64_t y);
+    static constexpr uint64_t Encode(uint64_t x);
+    static constexpr uint64_t Decode(uint64_t x);
+};
+
+using Goldilocks = PrimeField<0xFFFFFFFF00000001>; // 2^64 - 2^32 + 1, two-adicity 32
+using BabyBear = PrimeField<0x78000001>;           // 15 * 2^27 + 1, two-adicity 27
+
+/* Initialize static members */
+template <uint64_t P> inline uint32_t PrimeField<P>::sSeed = 0u;
+
+/* Define member functions */
+template <uint64_t P> constexpr PrimeField<P>::PrimeField() : mValue(0u)
+{
+}
+
+template <uint64_t P>
+template <std::integral T>
+constexpr PrimeField<P>::PrimeField(T value) : mValue(Encode((uint64_t)value % BASE))
+{
+}
+
+// A hash digest is taken as the representation itself, which is as uniform as the canonical value
+template <uint64_t P> PrimeField<P>::PrimeField(unsigned char* addr)
+{
+    std::memcpy(&mValue, addr, sizeof(uint64_t));
+    mValue = mValue % BASE;
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::GetBase()
+{
+    return BASE;
+}
+
+template <uint64_t P> uint32_t PrimeField<P>::GetSeed()
+{
+    return sSeed;
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::GetValue() const
+{
+    return Decode(mValue);
+}
+
+template <uint64_t P> void PrimeField<P>::SetSeed(uint32_t seed)
+{
+    sSeed = seed;
+    ChaChaPrg::SetGlobalSeed(seed);
+}
+
+template <uint64_t P> PrimeField<P> PrimeField<P>::GenerateRandom()
+{
+    PrimeField value;
+    FillRandom(&value, 1);
+    return value;
+}
+
+template <uint64_t P> PrimeField<P> PrimeField<P>::GenerateRandomAbove(uint64_t min)
+{
+    assert(min < BASE);
+
+    PrimeField value;
+    do
+    {
+        FillRandom(&value, 1);
+    } while (value.GetValue() < min);
+    return value;
+}
+
+// Uniform over [0, P) by rejection on masked words; a uniform representation is a uniform element
+template <uint64_t P> void PrimeField<P>::FillRandom(PrimeField* values, const size_t length)
+{
+    ChaChaPrg& prg = ChaChaPrg::GetThreadLocal();
+    prg.Fill((uint64_t*)values, length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        values[i].mValue &= RANDOM_MASK;
+        while (values[i].mValue >= BASE)
+        {
+            values[i].mValue = prg.Next64() & RANDOM_MASK;
+        }
+    }
+}
+
+template <uint64_t P> void PrimeField<P>::Reverse(PrimeField* begin, PrimeField* end)
+{
+    const size_t length = (end - begin + 1) / 2;
+
+    assert(length > 0);
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        PrimeField temp = *begin;
+        *begin = *end;
+        *end = temp;
+        ++begin;
+        --end;
+    }
+}
+
+// Montgomery's trick : one inversion and 3(n - 1) multiplications, zeros are left as they are like Invert()
+template <uint64_t P> void PrimeField<P>::BatchInvert(std::span<PrimeField> values)
+{
+    if (values.empty())
+    {
+        return;
+    }
+
+    const PrimeField zero((uint64_t)0);
+    PrimeField* const prefixes = new PrimeField[values.size()];
+    PrimeField product((uint64_t)1);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        prefixes[i] = product;
+        if (values[i] != zero)
+        {
+            product *= values[i];
+        }
+    }
+
+    PrimeField inverse = product.Invert();
+    for (size_t i = values.size(); i-- > 0;)
+    {
+        if (values[i] != zero)
+        {
+            const PrimeField value = values[i];
+            values[i] = inverse * prefixes[i];
+            inverse *= value;
+        }
+    }
+
+    delete[] prefixes;
+}
+
+// Values are always fully reduced, so the representation is already unique
+template <uint64_t P> void PrimeField<P>::Canonicalize(PrimeField* /*values*/, const size_t /*length*/)
+{
+}
+
+template <uint64_t P> constexpr size_t PrimeField<P>::GetTwoAdicity()
+{
+    size_t twoAdicity = 0u;
+    while (((BASE - 1u) >> twoAdicity) % 2u == 0u)
+    {
+        ++twoAdicity;
+    }
+    return twoAdicity;
+}
+
+// c^((P - 1) / 2^s) has order exactly 2^s for a non-residue c, and squaring it halves the order
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::GetRootOfUnity(size_t logOrder)
+{
+    assert(logOrder <= GetTwoAdicity());
+
+    const PrimeField minusOne = -PrimeField((uint64_t)1);
+    uint64_t nonResidue = 2u;
+    while (PrimeField(nonResidue).Pow((BASE - 1u) / 2u) != minusOne)
+    {
+        ++nonResidue;
+    }
+
+    PrimeField root = PrimeField(nonResidue).Pow((BASE - 1u) >> GetTwoAdicity());
+    for (size_t i = logOrder; i < GetTwoAdicity(); ++i)
+    {
+        root *= root;
+    }
+    return root;
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::Invert() const
+{
+    return this->Pow(BASE - 2u);
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::Pow(uint64_t exp) const
+{
+    PrimeField result((uint64_t)1);
+    PrimeField base = *this;
+    while (exp > 0)
+    {
+        if (exp % 2u == 1u)
+        {
+            result *= base;
+        }
+        exp = exp >> 1;
+        base *= base;
+    }
+    return result;
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::operator+(const PrimeField& op) const
+{
+    PrimeField result = *this;
+    result += op;
+    return result;
+}
+
+// a + b < 2P : subtract P once if the sum is at least P or has wrapped around 2^64
+template <uint64_t P> constexpr PrimeField<P>& PrimeField<P>::operator+=(const PrimeField& op)
+{
+    const uint64_t sum = this->mValue + op.mValue;
+    this->mValue = (sum < op.mValue || sum >= BASE) ? sum - BASE : sum;
+    return *this;
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::operator-(const PrimeField& op) const
+{
+    PrimeField result = *this;
+    result -= op;
+    return result;
+}
+
+template <uint64_t P> constexpr PrimeField<P>& PrimeField<P>::operator-=(const PrimeField& op)
+{
+    const uint64_t difference = this->mValue - op.mValue;
+    this->mValue = this->mValue < op.mValue ? difference + BASE : difference;
+    return *this;
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::operator-() const
+{
+    PrimeField result;
+    result.mValue = this->mValue == 0u ? 0u : BASE - this->mValue;
+    return result;
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::operator*(const PrimeField& op) const
+{
+    PrimeField result;
+    result.mValue = Multiply(this->mValue, op.mValue);
+    return result;
+}
+
+template <uint64_t P> constexpr PrimeField<P>& PrimeField<P>::operator*=(const PrimeField& op)
+{
+    this->mValue = Multiply(this->mValue, op.mValue);
+    return *this;
+}
+
+template <uint64_t P> constexpr PrimeField<P> PrimeField<P>::operator/(const PrimeField& op) const
+{
+    return (*this) * op.Invert();
+}
+
+template <uint64_t P> constexpr PrimeField<P>& PrimeField<P>::operator/=(const PrimeField& op)
+{
+    this->mValue = Multiply(this->mValue, op.Invert().mValue);
+    return *this;
+}
+
+template <uint64_t P> constexpr bool PrimeField<P>::operator==(const PrimeField& op) const
+{
+    return this->mValue == op.mValue;
+}
+
+template <uint64_t P> constexpr bool PrimeField<P>::operator>(const PrimeField& op) const
+{
+    return this->GetValue() > op.GetValue();
+}
+
+template <uint64_t P> constexpr bool PrimeField<P>::operator<(const PrimeField& op) const
+{
+    return this->GetValue() < op.GetValue();
+}
+
+template <uint64_t P> constexpr bool PrimeField<P>::operator>=(const PrimeField& op) const
+{
+    return this->GetValue() >= op.GetValue();
+}
+
+template <uint64_t P> constexpr bool PrimeField<P>::operator<=(const PrimeField& op) const
+{
+    return this->GetValue() <= op.GetValue();
+}
+
+template <uint64_t P> constexpr bool PrimeField<P>::operator!=(const PrimeField& op) const
+{
+    return this->mValue != op.mValue;
+}
+
+// Newton iteration doubles the number of correct low bits of P^-1 each step (P * P = 1 mod 8 to start)
+template <uint64_t P> constexpr uint64_t PrimeField<P>::ComputeMontgomeryFactor()
+{
+    uint64_t inverse = BASE;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        inverse *= 2u - BASE * inverse;
+    }
+    return 0u - inverse;
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::ComputeRSquared()
+{
+    uint64_t value = 1u;
+    for (size_t i = 0; i < 128; ++i)
+    {
+        const uint64_t doubled = value << 1;
+        value = (doubled < value || doubled >= BASE) ? doubled - BASE : doubled;
+    }
+    return value;
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::ComputeRandomMask()
+{
+    uint64_t mask = 1u;
+    while (mask < BASE - 1u && mask != ~(uint64_t)0)
+    {
+        mask = (mask << 1) | 1u;
+    }
+    return mask;
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::MultiplyWide(uint64_t x, uint64_t y, uint64_t& high)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const uint64_t lowX = x & 0xFFFFFFFF;
+    const uint64_t highX = x >> 32;
+    const uint64_t lowY = y & 0xFFFFFFFF;
+    const uint64_t highY = y >> 32;
+
+    const uint64_t lowLow = lowX * lowY;
+    const uint64_t middle0 = highX * lowY + (lowLow >> 32);
+    const uint64_t middle1 = lowX * highY + (middle0 & 0xFFFFFFFF);
+    high = highX * highY + (middle0 >> 32) + (middle1 >> 32);
+    return (middle1 << 32) | (lowLow & 0xFFFFFFFF);
+#else
+    const unsigned __int128 product = (unsigned __int128)x * y;
+    high = (uint64_t)(product >> 64);
+    return (uint64_t)product;
+#endif
+}
+
+// Value of (high * 2^64 + low) in the representation of the field, given high < P
+template <uint64_t P> constexpr uint64_t PrimeField<P>::Reduce(uint64_t low, uint64_t high)
+{
+    if constexpr (IS_GOLDILOCKS)
+    {
+        // 2^64 = 2^32 - 1 and 2^96 = -1 (mod P)
+        const uint64_t highHigh = high >> 32;
+        const uint64_t highLow = high & EPSILON;
+
+        uint64_t t0 = low - highHigh;
+        if (low < highHigh)
+        {
+            t0 -= EPSILON;
+        }
+        const uint64_t t1 = (highLow << 32) - highLow;
+        uint64_t result = t0 + t1;
+        if (result < t1)
+        {
+            result += EPSILON;
+        }
+        return result >= BASE ? result - BASE : result;
+    }
+    else
+    {
+        // Montgomery reduction : (x + m * P) / 2^64 with m = x * (-P^-1) mod 2^64, which is below 2P
+        uint64_t mpHigh = 0u;
+        MultiplyWide(low * M_FACTOR, BASE, mpHigh);
+        const uint64_t carry = low != 0u ? 1u : 0u;
+        const uint64_t sum = high + mpHigh + carry;
+        return (sum < high || sum >= BASE) ? sum - BASE : sum;
+    }
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::Multiply(uint64_t x, uint64_t y)
+{
+    uint64_t high = 0u;
+    const uint64_t low = MultiplyWide(x, y, high);
+    return Reduce(low, high);
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::Encode(uint64_t x)
+{
+    if constexpr (IS_GOLDILOCKS)
+    {
+        return x;
+    }
+    else
+    {
+        return Multiply(x, R_SQUARED);
+    }
+}
+
+template <uint64_t P> constexpr uint64_t PrimeField<P>::Decode(uint64_t x)
+{
+    if constexpr (IS_GOLDILOCKS)
+    {
+        return x;
+    }
+    else
+    {
+        return Reduce(x, 0u);
+    }
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef REDUCTION_POLICY_H
+#define REDUCTION_POLICY_H
+
+/*
+ * Reduction policies of the Mersenne field types (BasicMpint32, BasicMpint64).
+ * Every operation folds its result below 2p and then calls Finish, so a policy decides how far to go from there.
+ * Under a non-canonical policy values stay in [0, 2p) across operations and are made canonical only where the
+ * representation is observed : comparison, GetValue, Canonicalize (before hashing or serialization).
+ */
+
+/* Canonical after every operation, by a compare-and-subtract */
+class EagerReduction
+{
+public:
+    static constexpr bool IS_CANONICAL = true;
+
+    template <typename T> static constexpr T Finish(T x, T base);
+};
+
+/* Canonical after every operation, by a masked subtraction without a data-dependent branch */
+class BranchFreeReduction
+{
+public:
+    static constexpr bool IS_CANONICAL = true;
+
+    template <typename T> static constexpr T Finish(T x, T base);
+};
+
+/* Values stay in [0, 2p) */
+class LazyReduction
+{
+public:
+    static constexpr bool IS_CANONICAL = false;
+
+    template <typename T> static constexpr T Finish(T x, T base);
+};
+
+template <typename T> constexpr T EagerReduction::Finish(T x, T base)
+{
+    return x >= base ? x - base : x;
+}
+
+template <typename T> constexpr T BranchFreeReduction::Finish(T x, T base)
+{
+    return x - (base & ((T)0 - (T)(x >= base)));
+}
+
+template <typename T> constexpr T LazyReduction::Finish(T x, T /*base*/)
+{
+    return x;
+}
+
+#endif
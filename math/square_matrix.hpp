@@ -1,6 +1,8 @@
 #ifndef SQUARE_MATRIX_H
 #define SQUARE_MATRIX_H
 
+#include "../math/vector_kernel.hpp"
+
 template <typename Int> class SquareMatrix
 {
 public:
@@ -11,6 +13,7 @@ public:
 
     void Inverse();
     Int Get(size_t i, size_t j);
+    const Int* GetRow(size_t i) const;
 
 private:
     SquareMatrix(Int* xs, const size_t nXs); // Create a square Vandermonde matrix
@@ -64,22 +67,18 @@ template <typename Int> void SquareMatrix<Int>::Inverse()
 
         assert(pivot != Int((uint64_t)0)); // Singular matrix, no inverse
 
-        for (size_t j = 0; j < mSize; ++j)
-        {
-            mValues[i * mSize + j] /= pivot;
-            invValues[i * mSize + j] /= pivot;
-        }
+        // Invert the pivot once and scale the row by it
+        const Int pivotInverse = pivot.Invert();
+        VectorKernel<Int>::Scale(mValues + i * mSize, mValues + i * mSize, pivotInverse, mSize);
+        VectorKernel<Int>::Scale(invValues + i * mSize, invValues + i * mSize, pivotInverse, mSize);
 
         for (size_t k = 0; k < mSize; ++k)
         {
             if (k != i)
             {
-                Int factor = mValues[k * mSize + i];
-                for (size_t j = 0; j < mSize; ++j)
-                {
-                    mValues[k * mSize + j] -= factor * mValues[i * mSize + j];
-                    invValues[k * mSize + j] -= factor * invValues[i * mSize + j];
-                }
+                const Int factor = -mValues[k * mSize + i];
+                VectorKernel<Int>::Axpy(mValues + k * mSize, factor, mValues + i * mSize, mSize);
+                VectorKernel<Int>::Axpy(invValues + k * mSize, factor, invValues + i * mSize, mSize);
             }
         }
     }
@@ -93,6 +92,11 @@ template <typename Int> Int SquareMatrix<Int>::Get(size_t i, size_t j)
     return mValues[i * mSize + j];
 }
 
+template <typename Int> const Int* SquareMatrix<Int>::GetRow(size_t i) const
+{
+    return mValues + i * mSize;
+}
+
 template <typename Int> SquareMatrix<Int>::SquareMatrix(Int* xs, const size_t nXs)
 {
     assert(nXs >= 2);
@@ -0,0 +1,1298 @@
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+
+#include "cpu_features.hpp"
+#include "packed_codec.hpp"
+#include "vector_kernel.hpp"
+
+#if defined(CPU_FEATURES_X86)
+#include <immintrin.h>
+#endif
+
+static_assert(sizeof(Mpint64) == sizeof(uint64_t) && std::is_trivially_copyable_v<Mpint64>);
+static_assert(sizeof(Mpint32) == sizeof(uint32_t) && std::is_trivially_copyable_v<Mpint32>);
+
+static const uint64_t P61 = 0x1FFFFFFFFFFFFFFF; // 2^61 - 1
+static const uint64_t M29 = 0x1FFFFFFF;         // 2^29 - 1
+static const uint32_t P31 = 0x7FFFFFFF;         // 2^31 - 1
+
+static const size_t INGEST_CHUNK_BYTES = 16384; // Byte ingestion copies and reduces in chunks that stay in L1
+
+/* Function table of one backend over the raw representation (uint64_t for Mpint64, uint32_t for Mpint32) */
+template <typename Word> struct KernelBackend
+{
+    const char* name;
+    void (*add)(Word* dst, const Word* op0, const Word* op1, size_t length);
+    void (*sub)(Word* dst, const Word* op0, const Word* op1, size_t length);
+    void (*mul)(Word* dst, const Word* op0, const Word* op1, size_t length);
+    void (*scale)(Word* dst, const Word* op, Word scalar, size_t length);
+    void (*axpy)(Word* dst, Word scalar, const Word* op, size_t length);
+    Word (*dot)(const Word* op0, const Word* op1, size_t length);
+    void (*ingest)(Word* dst, const Word* src, size_t length); // Any words to canonical values
+    bool (*validate)(const Word* src, size_t length);          // Whether all words are canonical
+    void (*pack)(unsigned char* dst, const Word* src, size_t length);
+    void (*unpack)(Word* dst, const unsigned char* src, size_t length);
+};
+
+/*
+ * Bit packing : B-bit values back to back in little-endian order, so PERIOD (the word width) values fill exactly
+ * B words. SIMD backends pack whole periods with the gather tables below and leave the rest to BitPacking.
+ */
+template <size_t B, typename Word> struct PackingTable
+{
+    static constexpr size_t PERIOD = sizeof(Word) * 8;
+
+    int32_t packSource[3][PERIOD];   // Values feeding word j (B words, padded to PERIOD)
+    Word packShift[3][PERIOD];       // Right shift of the first value, left shifts of the others (PERIOD : unused)
+    int32_t unpackSource[2][PERIOD]; // Words feeding value i
+    Word unpackShift[2][PERIOD];     // Right shift of the first word, left shift of the second (PERIOD : unused)
+};
+
+template <size_t B, typename Word> static constexpr PackingTable<B, Word> MakePackingTable()
+{
+    const size_t period = PackingTable<B, Word>::PERIOD;
+    PackingTable<B, Word> table = {};
+    for (size_t j = 0; j < period; ++j)
+    {
+        const size_t value = j * period / B;
+        const size_t offset = j * period % B;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            const size_t shift = k == 0 ? offset : k * B - offset;
+            const bool isUsed = j < B && (k == 0 || shift < period);
+            table.packSource[k][j] = isUsed ? (int32_t)(value + k) : 0;
+            table.packShift[k][j] = isUsed ? (Word)shift : (Word)period;
+        }
+    }
+    for (size_t i = 0; i < period; ++i)
+    {
+        const size_t word = i * B / period;
+        const size_t offset = i * B % period;
+        const bool isUsed = offset != 0 && word + 1 < B;
+        table.unpackSource[0][i] = (int32_t)word;
+        table.unpackShift[0][i] = (Word)offset;
+        table.unpackSource[1][i] = isUsed ? (int32_t)(word + 1) : 0;
+        table.unpackShift[1][i] = isUsed ? (Word)(period - offset) : (Word)period;
+    }
+    return table;
+}
+
+/* Scalar backend : Z_{2^61 - 1} */
+
+static inline uint64_t Fold61(uint64_t x)
+{
+    return (x & P61) + (x >> 61);
+}
+
+static inline uint64_t Canonicalize61(uint64_t x)
+{
+    x = Fold61(x);
+    return x >= P61 ? x - P61 : x;
+}
+
+// Same limb split as Mpint64::Multiply, rearranged so every partial product maps onto a 32x32->64 multiply
+static inline uint64_t MultiplyUnreduced61(uint64_t x, uint64_t y)
+{
+    const uint64_t hiX = x >> 32;
+    const uint64_t hiY = y >> 32;
+    const uint64_t lowX = x & 0xFFFFFFFF;
+    const uint64_t lowY = y & 0xFFFFFFFF;
+
+    const uint64_t hh = hiX * hiY;
+    const uint64_t mid = hiX * lowY + lowX * hiY;
+    const uint64_t ll = lowX * lowY;
+
+    // 2^64 = 8, 2^61 = 1 (mod 2^61 - 1)
+    return (hh << 3) + (mid >> 29) + ((mid & M29) << 32) + (ll & P61) + (ll >> 61);
+}
+
+static void AddScalar61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize61(op0[i] + op1[i]);
+    }
+}
+
+static void SubScalar61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize61(op0[i] + (P61 << 1) - op1[i]);
+    }
+}
+
+static void MulScalar61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize61(MultiplyUnreduced61(op0[i], op1[i]));
+    }
+}
+
+static void ScaleScalar61(uint64_t* dst, const uint64_t* op, uint64_t scalar, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize61(MultiplyUnreduced61(op[i], scalar));
+    }
+}
+
+static void AxpyScalar61(uint64_t* dst, uint64_t scalar, const uint64_t* op, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize61(Fold61(dst[i]) + Fold61(MultiplyUnreduced61(op[i], scalar)));
+    }
+}
+
+static uint64_t DotScalar61(const uint64_t* op0, const uint64_t* op1, size_t length)
+{
+    const Mpint64* const x = (const Mpint64*)op0;
+    const Mpint64* const y = (const Mpint64*)op1;
+    Accumulator<Mpint64> result;
+    for (size_t i = 0; i < length; ++i)
+    {
+        result.MultiplyAdd(x[i], y[i]);
+    }
+    return result.Get().GetValue();
+}
+
+static void IngestScalar61(uint64_t* dst, const uint64_t* src, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize61(src[i]);
+    }
+}
+
+static bool ValidateScalar61(const uint64_t* src, size_t length)
+{
+    uint64_t isAbove = 0u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        isAbove |= (uint64_t)(src[i] >= P61);
+    }
+    return isAbove == 0u;
+}
+
+static void PackScalar61(unsigned char* dst, const uint64_t* src, size_t length)
+{
+    uint64_t values[64];
+    for (size_t i = 0; i < length; i += 64)
+    {
+        const size_t currentLength = std::min((size_t)64, length - i);
+        IngestScalar61(values, src + i, currentLength);
+        BitPacking::Pack<61>(dst + BitPacking::GetPackedBytes(i, 61), values, currentLength);
+    }
+}
+
+static void UnpackScalar61(uint64_t* dst, const unsigned char* src, size_t length)
+{
+    BitPacking::Unpack<61>(dst, src, length);
+    IngestScalar61(dst, dst, length);
+}
+
+/* Scalar backend : Z_{2^31 - 1} */
+
+static inline uint64_t Fold31(uint64_t x)
+{
+    return (x & P31) + (x >> 31);
+}
+
+static inline uint32_t Canonicalize31(uint64_t x)
+{
+    x = Fold31(Fold31(x));
+    return (uint32_t)(x >= P31 ? x - P31 : x);
+}
+
+static void AddScalar31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize31((uint64_t)op0[i] + op1[i]);
+    }
+}
+
+static void SubScalar31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize31((uint64_t)op0[i] + P31 - op1[i]);
+    }
+}
+
+static void MulScalar31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize31((uint64_t)op0[i] * op1[i]);
+    }
+}
+
+static void ScaleScalar31(uint32_t* dst, const uint32_t* op, uint32_t scalar, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize31((uint64_t)op[i] * scalar);
+    }
+}
+
+static void AxpyScalar31(uint32_t* dst, uint32_t scalar, const uint32_t* op, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize31(dst[i] + Fold31((uint64_t)op[i] * scalar));
+    }
+}
+
+static uint32_t DotScalar31(const uint32_t* op0, const uint32_t* op1, size_t length)
+{
+    const Mpint32* const x = (const Mpint32*)op0;
+    const Mpint32* const y = (const Mpint32*)op1;
+    Accumulator<Mpint32> result;
+    for (size_t i = 0; i < length; ++i)
+    {
+        result.MultiplyAdd(x[i], y[i]);
+    }
+    return result.Get().GetValue();
+}
+
+static void IngestScalar31(uint32_t* dst, const uint32_t* src, size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Canonicalize31(src[i]);
+    }
+}
+
+static bool ValidateScalar31(const uint32_t* src, size_t length)
+{
+    uint32_t isAbove = 0u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        isAbove |= (uint32_t)(src[i] >= P31);
+    }
+    return isAbove == 0u;
+}
+
+static void PackScalar31(unsigned char* dst, const uint32_t* src, size_t length)
+{
+    BitPacking::Pack<31>(dst, src, length);
+}
+
+static void UnpackScalar31(uint32_t* dst, const unsigned char* src, size_t length)
+{
+    BitPacking::Unpack<31>(dst, src, length);
+    IngestScalar31(dst, dst, length);
+}
+
+static const KernelBackend<uint64_t> sScalarBackend61 = {"scalar",         AddScalar61,  SubScalar61,    MulScalar61,
+                                                         ScaleScalar61,    AxpyScalar61, DotScalar61,    IngestScalar61,
+                                                         ValidateScalar61, PackScalar61, UnpackScalar61};
+static const KernelBackend<uint32_t> sScalarBackend31 = {"scalar",         AddScalar31,  SubScalar31,    MulScalar31,
+                                                         ScaleScalar31,    AxpyScalar31, DotScalar31,    IngestScalar31,
+                                                         ValidateScalar31, PackScalar31, UnpackScalar31};
+
+#if defined(CPU_FEATURES_X86)
+
+static constexpr PackingTable<61, uint64_t> sPackingTable61 = MakePackingTable<61, uint64_t>();
+static constexpr PackingTable<31, uint32_t> sPackingTable31 = MakePackingTable<31, uint32_t>();
+
+/* AVX2 backend : 4 x Z_{2^61 - 1} */
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Fold61x4(__m256i x)
+{
+    const __m256i p = _mm256_set1_epi64x(P61);
+    return _mm256_add_epi64(_mm256_and_si256(x, p), _mm256_srli_epi64(x, 61));
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Canonicalize61x4(__m256i x)
+{
+    const __m256i p = _mm256_set1_epi64x(P61);
+    x = Fold61x4(x);
+    // Values stay below 2^63, so the signed compare is exact
+    const __m256i isBelow = _mm256_cmpgt_epi64(p, x);
+    return _mm256_blendv_epi8(_mm256_sub_epi64(x, p), x, isBelow);
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i MultiplyUnreduced61x4(__m256i x, __m256i y)
+{
+    const __m256i p = _mm256_set1_epi64x(P61);
+    const __m256i m29 = _mm256_set1_epi64x(M29);
+    const __m256i hiX = _mm256_srli_epi64(x, 32);
+    const __m256i hiY = _mm256_srli_epi64(y, 32);
+
+    // _mm256_mul_epu32 only reads the low 32 bits of each lane, so x and y serve as their own low limbs
+    const __m256i hh = _mm256_mul_epu32(hiX, hiY);
+    const __m256i mid = _mm256_add_epi64(_mm256_mul_epu32(hiX, y), _mm256_mul_epu32(x, hiY));
+    const __m256i ll = _mm256_mul_epu32(x, y);
+
+    __m256i result = _mm256_add_epi64(_mm256_slli_epi64(hh, 3), _mm256_srli_epi64(mid, 29));
+    result = _mm256_add_epi64(result, _mm256_slli_epi64(_mm256_and_si256(mid, m29), 32));
+    result = _mm256_add_epi64(result, _mm256_and_si256(ll, p));
+    return _mm256_add_epi64(result, _mm256_srli_epi64(ll, 61));
+}
+
+CPU_FEATURES_TARGET("avx2") static void AddAvx2_61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1,
+                                                    size_t length)
+{
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize61x4(_mm256_add_epi64(x, y)));
+    }
+    AddScalar61(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void SubAvx2_61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1,
+                                                    size_t length)
+{
+    const __m256i twoP = _mm256_set1_epi64x(P61 << 1);
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        const __m256i diff = _mm256_sub_epi64(_mm256_add_epi64(x, twoP), y);
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize61x4(diff));
+    }
+    SubScalar61(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void MulAvx2_61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1,
+                                                    size_t length)
+{
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize61x4(MultiplyUnreduced61x4(x, y)));
+    }
+    MulScalar61(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void ScaleAvx2_61(uint64_t* dst, const uint64_t* op, uint64_t scalar,
+                                                      size_t length)
+{
+    const __m256i s = _mm256_set1_epi64x(scalar);
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize61x4(MultiplyUnreduced61x4(x, s)));
+    }
+    ScaleScalar61(dst + i, op + i, scalar, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void AxpyAvx2_61(uint64_t* dst, uint64_t scalar, const uint64_t* op,
+                                                     size_t length)
+{
+    const __m256i s = _mm256_set1_epi64x(scalar);
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(dst + i));
+        const __m256i sum = _mm256_add_epi64(Fold61x4(y), Fold61x4(MultiplyUnreduced61x4(x, s)));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize61x4(sum));
+    }
+    AxpyScalar61(dst + i, scalar, op + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static uint64_t DotAvx2_61(const uint64_t* op0, const uint64_t* op1, size_t length)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        acc = Fold61x4(_mm256_add_epi64(acc, Fold61x4(MultiplyUnreduced61x4(x, y))));
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256((__m256i*)lanes, acc);
+    uint64_t result = DotScalar61(op0 + i, op1 + i, length - i);
+    for (size_t j = 0; j < 4; ++j)
+    {
+        result = Fold61(result + lanes[j]);
+    }
+    return Canonicalize61(result);
+}
+
+CPU_FEATURES_TARGET("avx2") static void IngestAvx2_61(uint64_t* dst, const uint64_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize61x4(x));
+    }
+    IngestScalar61(dst + i, src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static bool ValidateAvx2_61(const uint64_t* src, size_t length)
+{
+    // x >= p exactly when one of the top 3 bits is set or x = p
+    const __m256i p = _mm256_set1_epi64x(P61);
+    __m256i isAbove = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        isAbove = _mm256_or_si256(isAbove, _mm256_or_si256(_mm256_srli_epi64(x, 61), _mm256_cmpeq_epi64(x, p)));
+    }
+    return _mm256_testz_si256(isAbove, isAbove) && ValidateScalar61(src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void UnpackAvx2_61(uint64_t* dst, const unsigned char* src, size_t length)
+{
+    const __m256i p = _mm256_set1_epi64x(P61);
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        const long long* const words = (const long long*)(src + BitPacking::GetPackedBytes(i, 61));
+        for (size_t j = 0; j < 64; j += 4)
+        {
+            const __m128i lowIndex = _mm_loadu_si128((const __m128i*)(sPackingTable61.unpackSource[0] + j));
+            const __m128i highIndex = _mm_loadu_si128((const __m128i*)(sPackingTable61.unpackSource[1] + j));
+            const __m256i lowShift = _mm256_loadu_si256((const __m256i*)(sPackingTable61.unpackShift[0] + j));
+            const __m256i highShift = _mm256_loadu_si256((const __m256i*)(sPackingTable61.unpackShift[1] + j));
+            const __m256i low = _mm256_srlv_epi64(_mm256_i32gather_epi64(words, lowIndex, 8), lowShift);
+            const __m256i high = _mm256_sllv_epi64(_mm256_i32gather_epi64(words, highIndex, 8), highShift);
+            const __m256i value = _mm256_and_si256(_mm256_or_si256(low, high), p);
+            _mm256_storeu_si256((__m256i*)(dst + i + j), Canonicalize61x4(value));
+        }
+    }
+    UnpackScalar61(dst + i, src + BitPacking::GetPackedBytes(i, 61), length - i);
+}
+
+/* AVX2 backend : 8 x Z_{2^31 - 1} */
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Canonicalize31x8(__m256i x)
+{
+    // For x < 2p, x - p wraps above x exactly when x < p
+    return _mm256_min_epu32(x, _mm256_sub_epi32(x, _mm256_set1_epi32(P31)));
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Fold31x8(__m256i x)
+{
+    return _mm256_add_epi32(_mm256_and_si256(x, _mm256_set1_epi32(P31)), _mm256_srli_epi32(x, 31));
+}
+
+// Folded products of even lanes stay in 64-bit lanes so that the dot product can sum them without reduction
+CPU_FEATURES_TARGET("avx2") static inline void MultiplyFolded31x8(__m256i x, __m256i y, __m256i* even, __m256i* odd)
+{
+    const __m256i p = _mm256_set1_epi64x(P31);
+    const __m256i productEven = _mm256_mul_epu32(x, y);
+    const __m256i productOdd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+    *even = _mm256_add_epi64(_mm256_and_si256(productEven, p), _mm256_srli_epi64(productEven, 31));
+    *odd = _mm256_add_epi64(_mm256_and_si256(productOdd, p), _mm256_srli_epi64(productOdd, 31));
+}
+
+CPU_FEATURES_TARGET("avx2") static inline __m256i Multiply31x8(__m256i x, __m256i y)
+{
+    __m256i even, odd;
+    MultiplyFolded31x8(x, y, &even, &odd);
+    return Canonicalize31x8(_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA));
+}
+
+CPU_FEATURES_TARGET("avx2") static void AddAvx2_31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1,
+                                                    size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize31x8(_mm256_add_epi32(x, y)));
+    }
+    AddScalar31(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void SubAvx2_31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1,
+                                                    size_t length)
+{
+    const __m256i p = _mm256_set1_epi32(P31);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        const __m256i diff = _mm256_sub_epi32(x, y);
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_min_epu32(diff, _mm256_add_epi32(diff, p)));
+    }
+    SubScalar31(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void MulAvx2_31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1,
+                                                    size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Multiply31x8(x, y));
+    }
+    MulScalar31(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void ScaleAvx2_31(uint32_t* dst, const uint32_t* op, uint32_t scalar,
+                                                      size_t length)
+{
+    const __m256i s = _mm256_set1_epi32(scalar);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Multiply31x8(x, s));
+    }
+    ScaleScalar31(dst + i, op + i, scalar, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void AxpyAvx2_31(uint32_t* dst, uint32_t scalar, const uint32_t* op,
+                                                     size_t length)
+{
+    const __m256i s = _mm256_set1_epi32(scalar);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize31x8(_mm256_add_epi32(y, Multiply31x8(x, s))));
+    }
+    AxpyScalar31(dst + i, scalar, op + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static uint32_t DotAvx2_31(const uint32_t* op0, const uint32_t* op1, size_t length)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(op0 + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(op1 + i));
+        __m256i even, odd;
+        MultiplyFolded31x8(x, y, &even, &odd);
+        acc = _mm256_add_epi64(acc, _mm256_add_epi64(even, odd));
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256((__m256i*)lanes, acc);
+    uint64_t result = DotScalar31(op0 + i, op1 + i, length - i);
+    for (size_t j = 0; j < 4; ++j)
+    {
+        result += Canonicalize31(lanes[j]);
+    }
+    return Canonicalize31(result);
+}
+
+CPU_FEATURES_TARGET("avx2") static void IngestAvx2_31(uint32_t* dst, const uint32_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Canonicalize31x8(Fold31x8(x)));
+    }
+    IngestScalar31(dst + i, src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static bool ValidateAvx2_31(const uint32_t* src, size_t length)
+{
+    // x >= p exactly when max(x, p) = x
+    const __m256i p = _mm256_set1_epi32(P31);
+    __m256i isAbove = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + i));
+        isAbove = _mm256_or_si256(isAbove, _mm256_cmpeq_epi32(_mm256_max_epu32(x, p), x));
+    }
+    return _mm256_testz_si256(isAbove, isAbove) && ValidateScalar31(src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void PackAvx2_31(unsigned char* dst, const uint32_t* src, size_t length)
+{
+    alignas(32) uint32_t words[32];
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const int* const values = (const int*)(src + i);
+        for (size_t j = 0; j < 31; j += 8)
+        {
+            // A word never takes bits from a third value when B = 31
+            const __m256i lowIndex = _mm256_loadu_si256((const __m256i*)(sPackingTable31.packSource[0] + j));
+            const __m256i highIndex = _mm256_loadu_si256((const __m256i*)(sPackingTable31.packSource[1] + j));
+            const __m256i lowShift = _mm256_loadu_si256((const __m256i*)(sPackingTable31.packShift[0] + j));
+            const __m256i highShift = _mm256_loadu_si256((const __m256i*)(sPackingTable31.packShift[1] + j));
+            const __m256i low = _mm256_srlv_epi32(_mm256_i32gather_epi32(values, lowIndex, 4), lowShift);
+            const __m256i high = _mm256_sllv_epi32(_mm256_i32gather_epi32(values, highIndex, 4), highShift);
+            _mm256_store_si256((__m256i*)(words + j), _mm256_or_si256(low, high));
+        }
+        std::memcpy(dst + BitPacking::GetPackedBytes(i, 31), words, 31 * sizeof(uint32_t));
+    }
+    PackScalar31(dst + BitPacking::GetPackedBytes(i, 31), src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx2") static void UnpackAvx2_31(uint32_t* dst, const unsigned char* src, size_t length)
+{
+    const __m256i p = _mm256_set1_epi32(P31);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const int* const words = (const int*)(src + BitPacking::GetPackedBytes(i, 31));
+        for (size_t j = 0; j < 32; j += 8)
+        {
+            const __m256i lowIndex = _mm256_loadu_si256((const __m256i*)(sPackingTable31.unpackSource[0] + j));
+            const __m256i highIndex = _mm256_loadu_si256((const __m256i*)(sPackingTable31.unpackSource[1] + j));
+            const __m256i lowShift = _mm256_loadu_si256((const __m256i*)(sPackingTable31.unpackShift[0] + j));
+            const __m256i highShift = _mm256_loadu_si256((const __m256i*)(sPackingTable31.unpackShift[1] + j));
+            const __m256i low = _mm256_srlv_epi32(_mm256_i32gather_epi32(words, lowIndex, 4), lowShift);
+            const __m256i high = _mm256_sllv_epi32(_mm256_i32gather_epi32(words, highIndex, 4), highShift);
+            const __m256i value = _mm256_and_si256(_mm256_or_si256(low, high), p);
+            _mm256_storeu_si256((__m256i*)(dst + i + j), Canonicalize31x8(value));
+        }
+    }
+    UnpackScalar31(dst + i, src + BitPacking::GetPackedBytes(i, 31), length - i);
+}
+
+/* AVX-512 backend : 8 x Z_{2^61 - 1} */
+
+CPU_FEATURES_TARGET("avx512f") static inline __m512i Fold61x8(__m512i x)
+{
+    const __m512i p = _mm512_set1_epi64(P61);
+    return _mm512_add_epi64(_mm512_and_si512(x, p), _mm512_srli_epi64(x, 61));
+}
+
+CPU_FEATURES_TARGET("avx512f") static inline __m512i Canonicalize61x8(__m512i x)
+{
+    x = Fold61x8(x);
+    return _mm512_min_epu64(x, _mm512_sub_epi64(x, _mm512_set1_epi64(P61)));
+}
+
+CPU_FEATURES_TARGET("avx512f") static inline __m512i MultiplyUnreduced61x8(__m512i x, __m512i y)
+{
+    const __m512i p = _mm512_set1_epi64(P61);
+    const __m512i m29 = _mm512_set1_epi64(M29);
+    const __m512i hiX = _mm512_srli_epi64(x, 32);
+    const __m512i hiY = _mm512_srli_epi64(y, 32);
+
+    const __m512i hh = _mm512_mul_epu32(hiX, hiY);
+    const __m512i mid = _mm512_add_epi64(_mm512_mul_epu32(hiX, y), _mm512_mul_epu32(x, hiY));
+    const __m512i ll = _mm512_mul_epu32(x, y);
+
+    __m512i result = _mm512_add_epi64(_mm512_slli_epi64(hh, 3), _mm512_srli_epi64(mid, 29));
+    result = _mm512_add_epi64(result, _mm512_slli_epi64(_mm512_and_si512(mid, m29), 32));
+    result = _mm512_add_epi64(result, _mm512_and_si512(ll, p));
+    return _mm512_add_epi64(result, _mm512_srli_epi64(ll, 61));
+}
+
+CPU_FEATURES_TARGET("avx512f") static void AddAvx512_61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1,
+                                                         size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        _mm512_storeu_si512(dst + i, Canonicalize61x8(_mm512_add_epi64(x, y)));
+    }
+    AddScalar61(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void SubAvx512_61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1,
+                                                         size_t length)
+{
+    const __m512i twoP = _mm512_set1_epi64(P61 << 1);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        _mm512_storeu_si512(dst + i, Canonicalize61x8(_mm512_sub_epi64(_mm512_add_epi64(x, twoP), y)));
+    }
+    SubScalar61(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void MulAvx512_61(uint64_t* dst, const uint64_t* op0, const uint64_t* op1,
+                                                         size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        _mm512_storeu_si512(dst + i, Canonicalize61x8(MultiplyUnreduced61x8(x, y)));
+    }
+    MulScalar61(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void ScaleAvx512_61(uint64_t* dst, const uint64_t* op, uint64_t scalar,
+                                                           size_t length)
+{
+    const __m512i s = _mm512_set1_epi64(scalar);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m512i x = _mm512_loadu_si512(op + i);
+        _mm512_storeu_si512(dst + i, Canonicalize61x8(MultiplyUnreduced61x8(x, s)));
+    }
+    ScaleScalar61(dst + i, op + i, scalar, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void AxpyAvx512_61(uint64_t* dst, uint64_t scalar, const uint64_t* op,
+                                                          size_t length)
+{
+    const __m512i s = _mm512_set1_epi64(scalar);
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m512i x = _mm512_loadu_si512(op + i);
+        const __m512i y = _mm512_loadu_si512(dst + i);
+        const __m512i sum = _mm512_add_epi64(Fold61x8(y), Fold61x8(MultiplyUnreduced61x8(x, s)));
+        _mm512_storeu_si512(dst + i, Canonicalize61x8(sum));
+    }
+    AxpyScalar61(dst + i, scalar, op + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static uint64_t DotAvx512_61(const uint64_t* op0, const uint64_t* op1,
+                                                             size_t length)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        acc = Fold61x8(_mm512_add_epi64(acc, Fold61x8(MultiplyUnreduced61x8(x, y))));
+    }
+
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    uint64_t result = DotScalar61(op0 + i, op1 + i, length - i);
+    for (size_t j = 0; j < 8; ++j)
+    {
+        result = Fold61(result + lanes[j]);
+    }
+    return Canonicalize61(result);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void IngestAvx512_61(uint64_t* dst, const uint64_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        _mm512_storeu_si512(dst + i, Canonicalize61x8(_mm512_loadu_si512(src + i)));
+    }
+    IngestScalar61(dst + i, src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static bool ValidateAvx512_61(const uint64_t* src, size_t length)
+{
+    const __m512i p = _mm512_set1_epi64(P61);
+    __mmask8 isAbove = 0u;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        isAbove |= _mm512_cmpge_epu64_mask(_mm512_loadu_si512(src + i), p);
+    }
+    return isAbove == 0u && ValidateScalar61(src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void PackAvx512_61(unsigned char* dst, const uint64_t* src, size_t length)
+{
+    alignas(64) uint64_t words[64];
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        const uint64_t* const values = src + i;
+        for (size_t j = 0; j < 61; j += 8)
+        {
+            __m512i word = _mm512_setzero_si512();
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const __m256i index = _mm256_loadu_si256((const __m256i*)(sPackingTable61.packSource[k] + j));
+                const __m512i shift = _mm512_loadu_si512(sPackingTable61.packShift[k] + j);
+                const __m512i value = Canonicalize61x8(_mm512_i32gather_epi64(index, values, 8));
+                const __m512i part = k == 0 ? _mm512_srlv_epi64(value, shift) : _mm512_sllv_epi64(value, shift);
+                word = _mm512_or_si512(word, part);
+            }
+            _mm512_store_si512(words + j, word);
+        }
+        std::memcpy(dst + BitPacking::GetPackedBytes(i, 61), words, 61 * sizeof(uint64_t));
+    }
+    PackScalar61(dst + BitPacking::GetPackedBytes(i, 61), src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void UnpackAvx512_61(uint64_t* dst, const unsigned char* src, size_t length)
+{
+    const __m512i p = _mm512_set1_epi64(P61);
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        const unsigned char* const words = src + BitPacking::GetPackedBytes(i, 61);
+        for (size_t j = 0; j < 64; j += 8)
+        {
+            const __m256i lowIndex = _mm256_loadu_si256((const __m256i*)(sPackingTable61.unpackSource[0] + j));
+            const __m256i highIndex = _mm256_loadu_si256((const __m256i*)(sPackingTable61.unpackSource[1] + j));
+            const __m512i lowShift = _mm512_loadu_si512(sPackingTable61.unpackShift[0] + j);
+            const __m512i highShift = _mm512_loadu_si512(sPackingTable61.unpackShift[1] + j);
+            const __m512i low = _mm512_srlv_epi64(_mm512_i32gather_epi64(lowIndex, words, 8), lowShift);
+            const __m512i high = _mm512_sllv_epi64(_mm512_i32gather_epi64(highIndex, words, 8), highShift);
+            const __m512i value = _mm512_and_si512(_mm512_or_si512(low, high), p);
+            _mm512_storeu_si512(dst + i + j, Canonicalize61x8(value));
+        }
+    }
+    UnpackScalar61(dst + i, src + BitPacking::GetPackedBytes(i, 61), length - i);
+}
+
+/* AVX-512 backend : 16 x Z_{2^31 - 1} */
+
+CPU_FEATURES_TARGET("avx512f") static inline __m512i Canonicalize31x16(__m512i x)
+{
+    return _mm512_min_epu32(x, _mm512_sub_epi32(x, _mm512_set1_epi32(P31)));
+}
+
+CPU_FEATURES_TARGET("avx512f") static inline __m512i Fold31x16(__m512i x)
+{
+    return _mm512_add_epi32(_mm512_and_si512(x, _mm512_set1_epi32(P31)), _mm512_srli_epi32(x, 31));
+}
+
+CPU_FEATURES_TARGET("avx512f") static inline void MultiplyFolded31x16(__m512i x, __m512i y, __m512i* even,
+                                                                       __m512i* odd)
+{
+    const __m512i p = _mm512_set1_epi64(P31);
+    const __m512i productEven = _mm512_mul_epu32(x, y);
+    const __m512i productOdd = _mm512_mul_epu32(_mm512_srli_epi64(x, 32), _mm512_srli_epi64(y, 32));
+    *even = _mm512_add_epi64(_mm512_and_si512(productEven, p), _mm512_srli_epi64(productEven, 31));
+    *odd = _mm512_add_epi64(_mm512_and_si512(productOdd, p), _mm512_srli_epi64(productOdd, 31));
+}
+
+CPU_FEATURES_TARGET("avx512f") static inline __m512i Multiply31x16(__m512i x, __m512i y)
+{
+    __m512i even, odd;
+    MultiplyFolded31x16(x, y, &even, &odd);
+    return Canonicalize31x16(_mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32)));
+}
+
+CPU_FEATURES_TARGET("avx512f") static void AddAvx512_31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1,
+                                                         size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        _mm512_storeu_si512(dst + i, Canonicalize31x16(_mm512_add_epi32(x, y)));
+    }
+    AddScalar31(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void SubAvx512_31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1,
+                                                         size_t length)
+{
+    const __m512i p = _mm512_set1_epi32(P31);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        const __m512i diff = _mm512_sub_epi32(x, y);
+        _mm512_storeu_si512(dst + i, _mm512_min_epu32(diff, _mm512_add_epi32(diff, p)));
+    }
+    SubScalar31(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void MulAvx512_31(uint32_t* dst, const uint32_t* op0, const uint32_t* op1,
+                                                         size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        _mm512_storeu_si512(dst + i, Multiply31x16(x, y));
+    }
+    MulScalar31(dst + i, op0 + i, op1 + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void ScaleAvx512_31(uint32_t* dst, const uint32_t* op, uint32_t scalar,
+                                                           size_t length)
+{
+    const __m512i s = _mm512_set1_epi32(scalar);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m512i x = _mm512_loadu_si512(op + i);
+        _mm512_storeu_si512(dst + i, Multiply31x16(x, s));
+    }
+    ScaleScalar31(dst + i, op + i, scalar, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void AxpyAvx512_31(uint32_t* dst, uint32_t scalar, const uint32_t* op,
+                                                          size_t length)
+{
+    const __m512i s = _mm512_set1_epi32(scalar);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m512i x = _mm512_loadu_si512(op + i);
+        const __m512i y = _mm512_loadu_si512(dst + i);
+        _mm512_storeu_si512(dst + i, Canonicalize31x16(_mm512_add_epi32(y, Multiply31x16(x, s))));
+    }
+    AxpyScalar31(dst + i, scalar, op + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static uint32_t DotAvx512_31(const uint32_t* op0, const uint32_t* op1,
+                                                             size_t length)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m512i x = _mm512_loadu_si512(op0 + i);
+        const __m512i y = _mm512_loadu_si512(op1 + i);
+        __m512i even, odd;
+        MultiplyFolded31x16(x, y, &even, &odd);
+        acc = _mm512_add_epi64(acc, _mm512_add_epi64(even, odd));
+    }
+
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, acc);
+    uint64_t result = DotScalar31(op0 + i, op1 + i, length - i);
+    for (size_t j = 0; j < 8; ++j)
+    {
+        result += Canonicalize31(lanes[j]);
+    }
+    return Canonicalize31(result);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void IngestAvx512_31(uint32_t* dst, const uint32_t* src, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        _mm512_storeu_si512(dst + i, Canonicalize31x16(Fold31x16(_mm512_loadu_si512(src + i))));
+    }
+    IngestScalar31(dst + i, src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static bool ValidateAvx512_31(const uint32_t* src, size_t length)
+{
+    const __m512i p = _mm512_set1_epi32(P31);
+    __mmask16 isAbove = 0u;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        isAbove |= _mm512_cmpge_epu32_mask(_mm512_loadu_si512(src + i), p);
+    }
+    return isAbove == 0u && ValidateScalar31(src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void PackAvx512_31(unsigned char* dst, const uint32_t* src, size_t length)
+{
+    alignas(64) uint32_t words[32];
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const uint32_t* const values = src + i;
+        for (size_t j = 0; j < 31; j += 16)
+        {
+            const __m512i lowIndex = _mm512_loadu_si512(sPackingTable31.packSource[0] + j);
+            const __m512i highIndex = _mm512_loadu_si512(sPackingTable31.packSource[1] + j);
+            const __m512i lowShift = _mm512_loadu_si512(sPackingTable31.packShift[0] + j);
+            const __m512i highShift = _mm512_loadu_si512(sPackingTable31.packShift[1] + j);
+            const __m512i low = _mm512_srlv_epi32(_mm512_i32gather_epi32(lowIndex, values, 4), lowShift);
+            const __m512i high = _mm512_sllv_epi32(_mm512_i32gather_epi32(highIndex, values, 4), highShift);
+            _mm512_store_si512(words + j, _mm512_or_si512(low, high));
+        }
+        std::memcpy(dst + BitPacking::GetPackedBytes(i, 31), words, 31 * sizeof(uint32_t));
+    }
+    PackScalar31(dst + BitPacking::GetPackedBytes(i, 31), src + i, length - i);
+}
+
+CPU_FEATURES_TARGET("avx512f") static void UnpackAvx512_31(uint32_t* dst, const unsigned char* src, size_t length)
+{
+    const __m512i p = _mm512_set1_epi32(P31);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const unsigned char* const words = src + BitPacking::GetPackedBytes(i, 31);
+        for (size_t j = 0; j < 32; j += 16)
+        {
+            const __m512i lowIndex = _mm512_loadu_si512(sPackingTable31.unpackSource[0] + j);
+            const __m512i highIndex = _mm512_loadu_si512(sPackingTable31.unpackSource[1] + j);
+            const __m512i lowShift = _mm512_loadu_si512(sPackingTable31.unpackShift[0] + j);
+            const __m512i highShift = _mm512_loadu_si512(sPackingTable31.unpackShift[1] + j);
+            const __m512i low = _mm512_srlv_epi32(_mm512_i32gather_epi32(lowIndex, words, 4), lowShift);
+            const __m512i high = _mm512_sllv_epi32(_mm512_i32gather_epi32(highIndex, words, 4), highShift);
+            const __m512i value = _mm512_and_si512(_mm512_or_si512(low, high), p);
+            _mm512_storeu_si512(dst + i + j, Canonicalize31x16(value));
+        }
+    }
+    UnpackScalar31(dst + i, src + BitPacking::GetPackedBytes(i, 31), length - i);
+}
+
+// Packing 61-bit values takes three 4-lane gathers per word, which loses to the scalar shifts on AVX2
+static const KernelBackend<uint64_t> sAvx2Backend61 = {"avx2",          AddAvx2_61,   SubAvx2_61,    MulAvx2_61,
+                                                       ScaleAvx2_61,    AxpyAvx2_61,  DotAvx2_61,    IngestAvx2_61,
+                                                       ValidateAvx2_61, PackScalar61, UnpackAvx2_61};
+static const KernelBackend<uint32_t> sAvx2Backend31 = {"avx2",          AddAvx2_31,  SubAvx2_31,    MulAvx2_31,
+                                                       ScaleAvx2_31,    AxpyAvx2_31, DotAvx2_31,    IngestAvx2_31,
+                                                       ValidateAvx2_31, PackAvx2_31, UnpackAvx2_31};
+static const KernelBackend<uint64_t> sAvx512Backend61 = {"avx512",      AddAvx512_61,    SubAvx512_61,
+                                                         MulAvx512_61,  ScaleAvx512_61,  AxpyAvx512_61,
+                                                         DotAvx512_61,  IngestAvx512_61, ValidateAvx512_61,
+                                                         PackAvx512_61, UnpackAvx512_61};
+static const KernelBackend<uint32_t> sAvx512Backend31 = {"avx512",      AddAvx512_31,    SubAvx512_31,
+                                                         MulAvx512_31,  ScaleAvx512_31,  AxpyAvx512_31,
+                                                         DotAvx512_31,  IngestAvx512_31, ValidateAvx512_31,
+                                                         PackAvx512_31, UnpackAvx512_31};
+
+#endif
+
+template <typename Word>
+static const KernelBackend<Word>* SelectBackend(const SimdLevel level, const KernelBackend<Word>* scalar,
+                                                const KernelBackend<Word>* avx2, const KernelBackend<Word>* avx512)
+{
+    switch (level)
+    {
+    case SimdLevel::Avx512:
+        return avx512;
+    case SimdLevel::Avx2:
+        return avx2;
+    default:
+        return scalar;
+    }
+}
+
+static const KernelBackend<uint64_t>* SelectBackend61(const SimdLevel level)
+{
+#if defined(CPU_FEATURES_X86)
+    return SelectBackend(level, &sScalarBackend61, &sAvx2Backend61, &sAvx512Backend61);
+#else
+    return &sScalarBackend61;
+#endif
+}
+
+static const KernelBackend<uint32_t>* SelectBackend31(const SimdLevel level)
+{
+#if defined(CPU_FEATURES_X86)
+    return SelectBackend(level, &sScalarBackend31, &sAvx2Backend31, &sAvx512Backend31);
+#else
+    return &sScalarBackend31;
+#endif
+}
+
+// Backends are chosen by CPUID on first use and may be replaced by SetSimdLevel
+static const KernelBackend<uint64_t>*& GetBackendSlot61()
+{
+    static const KernelBackend<uint64_t>* backend = SelectBackend61(CpuFeatures::GetSimdLevel());
+    return backend;
+}
+
+static const KernelBackend<uint32_t>*& GetBackendSlot31()
+{
+    static const KernelBackend<uint32_t>* backend = SelectBackend31(CpuFeatures::GetSimdLevel());
+    return backend;
+}
+
+static const KernelBackend<uint64_t>& GetBackend61()
+{
+    return *GetBackendSlot61();
+}
+
+static const KernelBackend<uint32_t>& GetBackend31()
+{
+    return *GetBackendSlot31();
+}
+
+/* VectorKernel<Mpint64> */
+
+void VectorKernel<Mpint64>::Add(Mpint64* dst, const Mpint64* op0, const Mpint64* op1, const size_t length)
+{
+    GetBackend61().add((uint64_t*)dst, (const uint64_t*)op0, (const uint64_t*)op1, length);
+}
+
+void VectorKernel<Mpint64>::Sub(Mpint64* dst, const Mpint64* op0, const Mpint64* op1, const size_t length)
+{
+    GetBackend61().sub((uint64_t*)dst, (const uint64_t*)op0, (const uint64_t*)op1, length);
+}
+
+void VectorKernel<Mpint64>::Mul(Mpint64* dst, const Mpint64* op0, const Mpint64* op1, const size_t length)
+{
+    GetBackend61().mul((uint64_t*)dst, (const uint64_t*)op0, (const uint64_t*)op1, length);
+}
+
+void VectorKernel<Mpint64>::Scale(Mpint64* dst, const Mpint64* op, const Mpint64 scalar, const size_t length)
+{
+    GetBackend61().scale((uint64_t*)dst, (const uint64_t*)op, scalar.GetValue(), length);
+}
+
+void VectorKernel<Mpint64>::Axpy(Mpint64* dst, const Mpint64 scalar, const Mpint64* op, const size_t length)
+{
+    GetBackend61().axpy((uint64_t*)dst, scalar.GetValue(), (const uint64_t*)op, length);
+}
+
+Mpint64 VectorKernel<Mpint64>::Dot(const Mpint64* op0, const Mpint64* op1, const size_t length)
+{
+    return Mpint64(GetBackend61().dot((const uint64_t*)op0, (const uint64_t*)op1, length));
+}
+
+void VectorKernel<Mpint64>::Ingest(Mpint64* dst, const Word* src, const size_t length)
+{
+    GetBackend61().ingest((Word*)dst, src, length);
+}
+
+void VectorKernel<Mpint64>::IngestBytes(Mpint64* dst, const unsigned char* src, const size_t length)
+{
+    const size_t chunkLength = INGEST_CHUNK_BYTES / sizeof(Word);
+    for (size_t i = 0; i < length; i += chunkLength)
+    {
+        const size_t currentLength = std::min(chunkLength, length - i);
+        std::memcpy(dst + i, src + i * sizeof(Word), currentLength * sizeof(Word));
+        GetBackend61().ingest((Word*)(dst + i), (const Word*)(dst + i), currentLength);
+    }
+}
+
+bool VectorKernel<Mpint64>::IsCanonical(const Word* src, const size_t length)
+{
+    return GetBackend61().validate(src, length);
+}
+
+Mpint64* VectorKernel<Mpint64>::IngestInPlace(Word* values, const size_t length)
+{
+    GetBackend61().ingest(values, values, length);
+    return (Mpint64*)values;
+}
+
+std::span<const Mpint64> VectorKernel<Mpint64>::View(const Word* values, const size_t length)
+{
+    assert(IsCanonical(values, length));
+
+    return std::span<const Mpint64>((const Mpint64*)values, length);
+}
+
+void VectorKernel<Mpint64>::Pack(unsigned char* dst, const Mpint64* src, const size_t length)
+{
+    GetBackend61().pack(dst, (const Word*)src, length);
+}
+
+void VectorKernel<Mpint64>::Unpack(Mpint64* dst, const unsigned char* src, const size_t length)
+{
+    GetBackend61().unpack((Word*)dst, src, length);
+}
+
+const char* VectorKernel<Mpint64>::GetBackendName()
+{
+    return GetBackend61().name;
+}
+
+bool VectorKernel<Mpint64>::SetSimdLevel(const SimdLevel level)
+{
+    if ((int)level > (int)CpuFeatures::GetSimdLevel())
+    {
+        return false;
+    }
+    GetBackendSlot61() = SelectBackend61(level);
+    return true;
+}
+
+/* VectorKernel<Mpint32> */
+
+void VectorKernel<Mpint32>::Add(Mpint32* dst, const Mpint32* op0, const Mpint32* op1, const size_t length)
+{
+    GetBackend31().add((uint32_t*)dst, (const uint32_t*)op0, (const uint32_t*)op1, length);
+}
+
+void VectorKernel<Mpint32>::Sub(Mpint32* dst, const Mpint32* op0, const Mpint32* op1, const size_t length)
+{
+    GetBackend31().sub((uint32_t*)dst, (const uint32_t*)op0, (const uint32_t*)op1, length);
+}
+
+void VectorKernel<Mpint32>::Mul(Mpint32* dst, const Mpint32* op0, const Mpint32* op1, const size_t length)
+{
+    GetBackend31().mul((uint32_t*)dst, (const uint32_t*)op0, (const uint32_t*)op1, length);
+}
+
+void VectorKernel<Mpint32>::Scale(Mpint32* dst, const Mpint32* op, const Mpint32 scalar, const size_t length)
+{
+    GetBackend31().scale((uint32_t*)dst, (const uint32_t*)op, scalar.GetValue(), length);
+}
+
+void VectorKernel<Mpint32>::Axpy(Mpint32* dst, const Mpint32 scalar, const Mpint32* op, const size_t length)
+{
+    GetBackend31().axpy((uint32_t*)dst, scalar.GetValue(), (const uint32_t*)op, length);
+}
+
+Mpint32 VectorKernel<Mpint32>::Dot(const Mpint32* op0, const Mpint32* op1, const size_t length)
+{
+    return Mpint32(GetBackend31().dot((const uint32_t*)op0, (const uint32_t*)op1, length));
+}
+
+void VectorKernel<Mpint32>::Ingest(Mpint32* dst, const Word* src, const size_t length)
+{
+    GetBackend31().ingest((Word*)dst, src, length);
+}
+
+void VectorKernel<Mpint32>::IngestBytes(Mpint32* dst, const unsigned char* src, const size_t length)
+{
+    const size_t chunkLength = INGEST_CHUNK_BYTES / sizeof(Word);
+    for (size_t i = 0; i < length; i += chunkLength)
+    {
+        const size_t currentLength = std::min(chunkLength, length - i);
+        std::memcpy(dst + i, src + i * sizeof(Word), currentLength * sizeof(Word));
+        GetBackend31().ingest((Word*)(dst + i), (const Word*)(dst + i), currentLength);
+    }
+}
+
+bool VectorKernel<Mpint32>::IsCanonical(const Word* src, const size_t length)
+{
+    return GetBackend31().validate(src, length);
+}
+
+Mpint32* VectorKernel<Mpint32>::IngestInPlace(Word* values, const size_t length)
+{
+    GetBackend31().ingest(values, values, length);
+    return (Mpint32*)values;
+}
+
+std::span<const Mpint32> VectorKernel<Mpint32>::View(const Word* values, const size_t length)
+{
+    assert(IsCanonical(values, length));
+
+    return std::span<const Mpint32>((const Mpint32*)values, length);
+}
+
+void VectorKernel<Mpint32>::Pack(unsigned char* dst, const Mpint32* src, const size_t length)
+{
+    GetBackend31().pack(dst, (const Word*)src, length);
+}
+
+void VectorKernel<Mpint32>::Unpack(Mpint32* dst, const unsigned char* src, const size_t length)
+{
+    GetBackend31().unpack((Word*)dst, src, length);
+}
+
+const char* VectorKernel<Mpint32>::GetBackendName()
+{
+    return GetBackend31().name;
+}
+
+bool VectorKernel<Mpint32>::SetSimdLevel(const SimdLevel level)
+{
+    if ((int)level > (int)CpuFeatures::GetSimdLevel())
+    {
+        return false;
+    }
+    GetBackendSlot31() = SelectBackend31(level);
+    return true;
+}
@@ -0,0 +1,170 @@
+#ifndef VECTOR_KERNEL_H
+#define VECTOR_KERNEL_H
+
+#include <cassert>
+#include <cstring>
+#include <span>
+#include <stdint.h>
+
+#include "../math/accumulator.hpp"
+#include "../math/cpu_features.hpp"
+#include "../math/mpint32.hpp"
+#include "../math/mpint64.hpp"
+
+/* Bulk element-wise arithmetic over arrays of field elements (dst may alias an operand) */
+template <typename Int> class VectorKernel
+{
+public:
+    static void Add(Int* dst, const Int* op0, const Int* op1, const size_t length);
+    static void Sub(Int* dst, const Int* op0, const Int* op1, const size_t length);
+    static void Mul(Int* dst, const Int* op0, const Int* op1, const size_t length);
+    static void Scale(Int* dst, const Int* op, const Int scalar, const size_t length);
+    static void Axpy(Int* dst, const Int scalar, const Int* op, const size_t length); // dst += scalar * op
+    static Int Dot(const Int* op0, const Int* op1, const size_t length);
+
+    /* Ingestion of raw machine integers, reduced to canonical field elements (dst may alias src) */
+    using Word = uint64_t;
+
+    static void Ingest(Int* dst, const Word* src, const size_t length);
+    static void IngestBytes(Int* dst, const unsigned char* src, const size_t length); // Little-endian words
+    static bool IsCanonical(const Word* src, const size_t length);
+};
+
+/*
+ * Mersenne fields dispatch to scalar, AVX2 or AVX-512 backends chosen once by CPUID (vector_kernel.cpp).
+ * Mpint64 inputs may be incompletely reduced (below 2^62) but Mpint32 inputs must be canonical.
+ * Outputs are always canonical.
+ * Words are stored as is by the field types, so ingestion can also work in place or hand out a zero-copy view.
+ * Pack writes canonical values back to back with no padding bits, see PackedCodec (packed_codec.hpp).
+ */
+template <> class VectorKernel<Mpint64>
+{
+public:
+    static void Add(Mpint64* dst, const Mpint64* op0, const Mpint64* op1, const size_t length);
+    static void Sub(Mpint64* dst, const Mpint64* op0, const Mpint64* op1, const size_t length);
+    static void Mul(Mpint64* dst, const Mpint64* op0, const Mpint64* op1, const size_t length);
+    static void Scale(Mpint64* dst, const Mpint64* op, const Mpint64 scalar, const size_t length);
+    static void Axpy(Mpint64* dst, const Mpint64 scalar, const Mpint64* op, const size_t length);
+    static Mpint64 Dot(const Mpint64* op0, const Mpint64* op1, const size_t length);
+
+    using Word = uint64_t;
+
+    static void Ingest(Mpint64* dst, const Word* src, const size_t length);
+    static void IngestBytes(Mpint64* dst, const unsigned char* src, const size_t length);
+    static bool IsCanonical(const Word* src, const size_t length);
+    static Mpint64* IngestInPlace(Word* values, const size_t length);              // Reduces and reuses the buffer
+    static std::span<const Mpint64> View(const Word* values, const size_t length); // Values must be canonical
+
+    static void Pack(unsigned char* dst, const Mpint64* src, const size_t length); // 61 bits per element
+    static void Unpack(Mpint64* dst, const unsigned char* src, const size_t length);
+
+    static const char* GetBackendName();
+    static bool SetSimdLevel(const SimdLevel level); // Backend of a level the CPU supports, for tests and measurements
+};
+
+template <> class VectorKernel<Mpint32>
+{
+public:
+    static void Add(Mpint32* dst, const Mpint32* op0, const Mpint32* op1, const size_t length);
+    static void Sub(Mpint32* dst, const Mpint32* op0, const Mpint32* op1, const size_t length);
+    static void Mul(Mpint32* dst, const Mpint32* op0, const Mpint32* op1, const size_t length);
+    static void Scale(Mpint32* dst, const Mpint32* op, const Mpint32 scalar, const size_t length);
+    static void Axpy(Mpint32* dst, const Mpint32 scalar, const Mpint32* op, const size_t length);
+    static Mpint32 Dot(const Mpint32* op0, const Mpint32* op1, const size_t length);
+
+    using Word = uint32_t;
+
+    static void Ingest(Mpint32* dst, const Word* src, const size_t length);
+    static void IngestBytes(Mpint32* dst, const unsigned char* src, const size_t length);
+    static bool IsCanonical(const Word* src, const size_t length);
+    static Mpint32* IngestInPlace(Word* values, const size_t length);              // Reduces and reuses the buffer
+    static std::span<const Mpint32> View(const Word* values, const size_t length); // Values must be canonical
+
+    static void Pack(unsigned char* dst, const Mpint32* src, const size_t length); // 31 bits per element
+    static void Unpack(Mpint32* dst, const unsigned char* src, const size_t length);
+
+    static const char* GetBackendName();
+    static bool SetSimdLevel(const SimdLevel level); // Backend of a level the CPU supports, for tests and measurements
+};
+
+template <typename Int> void VectorKernel<Int>::Add(Int* dst, const Int* op0, const Int* op1, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = op0[i] + op1[i];
+    }
+}
+
+template <typename Int> void VectorKernel<Int>::Sub(Int* dst, const Int* op0, const Int* op1, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = op0[i] - op1[i];
+    }
+}
+
+template <typename Int> void VectorKernel<Int>::Mul(Int* dst, const Int* op0, const Int* op1, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = op0[i] * op1[i];
+    }
+}
+
+template <typename Int> void VectorKernel<Int>::Scale(Int* dst, const Int* op, const Int scalar, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = op[i] * scalar;
+    }
+}
+
+template <typename Int> void VectorKernel<Int>::Axpy(Int* dst, const Int scalar, const Int* op, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] += scalar * op[i];
+    }
+}
+
+template <typename Int> Int VectorKernel<Int>::Dot(const Int* op0, const Int* op1, const size_t length)
+{
+    Accumulator<Int> result;
+    for (size_t i = 0; i < length; ++i)
+    {
+        result.MultiplyAdd(op0[i], op1[i]);
+    }
+    return result.Get();
+}
+
+template <typename Int> void VectorKernel<Int>::Ingest(Int* dst, const Word* src, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        dst[i] = Int(src[i]);
+    }
+}
+
+template <typename Int> void VectorKernel<Int>::IngestBytes(Int* dst, const unsigned char* src, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        Word word;
+        std::memcpy(&word, src + i * sizeof(Word), sizeof(Word));
+        dst[i] = Int(word);
+    }
+}
+
+template <typename Int> bool VectorKernel<Int>::IsCanonical(const Word* src, const size_t length)
+{
+    for (size_t i = 0; i < length; ++i)
+    {
+        if (src[i] >= Int::GetBase())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include <stdint.h>
+#include <vector>
+
+#include "test_check.hpp"
+#include "../math/accumulator.hpp"
+#include "../math/extension_field.hpp"
+#include "../math/gf2_64.hpp"
+#include "../math/lanes.hpp"
+#include "../math/mpint32.hpp"
+#include "../math/mpint64.hpp"
+
+/*
+ * Accumulated sums against term-by-term field arithmetic, for term counts around multiples of the fold interval.
+ * The largest operands are sums such as (p - 1) + (p - 1), which lazy policies keep in [p, 2p).
+ */
+template <typename Int> void CheckAccumulator(const char* name, const size_t foldInterval)
+{
+    const Int one((uint64_t)1);
+    const Int minusOne = Int((uint64_t)0) - one;
+    const std::vector<Int> largest = {minusOne + minusOne, minusOne + one, minusOne, minusOne + minusOne + minusOne};
+
+    std::vector<size_t> counts = {0, 1, 2};
+    for (size_t multiple = 1; multiple <= 3; ++multiple)
+    {
+        counts.push_back(multiple * foldInterval - 1u);
+        counts.push_back(multiple * foldInterval);
+        counts.push_back(multiple * foldInterval + 1u);
+    }
+
+    bool isValid = true;
+    for (const size_t count : counts)
+    {
+        for (const bool isRandom : {false, true})
+        {
+            std::vector<Int> op0(count);
+            std::vector<Int> op1(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                op0[i] = isRandom ? Int::GenerateRandom() + largest[i % largest.size()] : largest[i % largest.size()];
+                op1[i] = largest[(i + 1u) % largest.size()];
+            }
+
+            Accumulator<Int> products;
+            Accumulator<Int> mixed;
+            Int expectedProducts((uint64_t)0);
+            Int expectedMixed((uint64_t)0);
+            for (size_t i = 0; i < count; ++i)
+            {
+                products.MultiplyAdd(op0[i], op1[i]);
+                expectedProducts += op0[i] * op1[i];
+                if (i % 3u == 0)
+                {
+                    mixed.Add(op0[i]);
+                    expectedMixed += op0[i];
+                }
+                else
+                {
+                    mixed.MultiplyAdd(op0[i], op1[i]);
+                    expectedMixed += op0[i] * op1[i];
+                }
+            }
+            isValid = isValid && (products.Get() == expectedProducts) && (mixed.Get() == expectedMixed);
+        }
+    }
+    TestCheck::Check(isValid, name);
+}
+
+int main()
+{
+    CheckAccumulator<Mpint64>("accumulator of Mpint64",
+                              Accumulator<Mpint64>::FOLD_INTERVAL);
+    CheckAccumulator<BasicMpint64<EagerReduction>>("accumulator of eager Mpint64",
+                                                   Accumulator<BasicMpint64<EagerReduction>>::FOLD_INTERVAL);
+    CheckAccumulator<BasicMpint64<BranchFreeReduction>>(
+        "accumulator of branch-free Mpint64", Accumulator<BasicMpint64<BranchFreeReduction>>::FOLD_INTERVAL);
+    CheckAccumulator<Mpint32>("accumulator of Mpint32", Accumulator<Mpint32>::FOLD_INTERVAL);
+    CheckAccumulator<BasicMpint32<LazyReduction>>("accumulator of lazy Mpint32",
+                                                  Accumulator<BasicMpint32<LazyReduction>>::FOLD_INTERVAL);
+    CheckAccumulator<GF2_64>("accumulator of GF2_64", 64);
+    CheckAccumulator<Ext<Mpint64, 2>>("accumulator of Ext<Mpint64, 2>", Accumulator<Mpint64>::FOLD_INTERVAL);
+    CheckAccumulator<Lanes<Mpint32, 4>>("accumulator of Lanes<Mpint32, 4>", Accumulator<Mpint32>::FOLD_INTERVAL);
+
+    return TestCheck::GetFailureCount();
+}
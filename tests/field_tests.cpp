@@ -0,0 +1,113 @@
+#include <stdint.h>
+#include <vector>
+
+#include "test_check.hpp"
+#include "../math/extension_field.hpp"
+#include "../math/gf2_64.hpp"
+#include "../math/mpint128.hpp"
+#include "../math/mpint32.hpp"
+#include "../math/mpint64.hpp"
+#include "../math/ntt.hpp"
+#include "../math/prime_field.hpp"
+
+/* Field axioms on random values and on the edges 0, 1, 2 and p - 1, reached as sums so lazy fields see [p, 2p) */
+template <typename Int> void CheckFieldAxioms(const char* name)
+{
+    const Int zero((uint64_t)0);
+    const Int one((uint64_t)1);
+    const Int minusOne = zero - one;
+
+    std::vector<Int> values = {zero, one, one + one, minusOne, minusOne + minusOne, minusOne + one};
+    for (size_t i = 0; i < 64; ++i)
+    {
+        values.push_back(Int::GenerateRandom());
+    }
+
+    bool isValid = true;
+    for (const Int& a : values)
+    {
+        isValid = isValid && (a + zero == a) && (a * one == a) && (a * zero == zero) && (a - a == zero);
+        isValid = isValid && (a + (-a) == zero) && (-(-a) == a);
+        if (a != zero)
+        {
+            isValid = isValid && (a * a.Invert() == one) && (a / a == one);
+        }
+        for (const Int& b : values)
+        {
+            isValid = isValid && (a + b == b + a) && (a * b == b * a) && ((a - b) + b == a);
+            const Int& c = values[(&b - values.data() + 7) % values.size()];
+            isValid = isValid && ((a + b) + c == a + (b + c)) && ((a * b) * c == a * (b * c));
+            isValid = isValid && (a * (b + c) == a * b + a * c);
+        }
+    }
+    TestCheck::Check(isValid, name);
+
+    std::vector<Int> inverses(values.begin() + 1, values.end());
+    inverses.erase(inverses.begin() + 4); // minusOne + one is zero
+    std::vector<Int> expected(inverses);
+    for (Int& value : expected)
+    {
+        value = value.Invert();
+    }
+    Int::BatchInvert(inverses);
+    TestCheck::Check(inverses == expected, name);
+}
+
+// Forward is the DFT in bit-reversed order, and Inverse undoes it
+template <typename Int> void CheckNttAgainstDft(const char* name)
+{
+    for (size_t logSize = 0; logSize <= 7; ++logSize)
+    {
+        const size_t size = (size_t)1 << logSize;
+        std::vector<Int> coefficients(size);
+        Int::FillRandom(coefficients.data(), size);
+
+        std::vector<Int> values(coefficients);
+        const Ntt<Int>& ntt = Ntt<Int>::GetInstance(logSize);
+        ntt.Forward(values.data());
+
+        const Int root = Int::GetRootOfUnity(logSize);
+        bool isValid = true;
+        for (size_t k = 0; k < size; ++k)
+        {
+            size_t reversed = 0;
+            for (size_t bit = 0; bit < logSize; ++bit)
+            {
+                reversed |= ((k >> bit) & 1u) << (logSize - 1u - bit);
+            }
+
+            const Int point = root.Pow(k);
+            Int value((uint64_t)0);
+            Int power((uint64_t)1);
+            for (size_t j = 0; j < size; ++j)
+            {
+                value += coefficients[j] * power;
+                power *= point;
+            }
+            isValid = isValid && (values[reversed] == value);
+        }
+
+        ntt.Inverse(values.data());
+        TestCheck::Check(isValid && values == coefficients, name);
+    }
+}
+
+int main()
+{
+    CheckFieldAxioms<Mpint32>("field axioms of Mpint32");
+    CheckFieldAxioms<BasicMpint32<LazyReduction>>("field axioms of lazy Mpint32");
+    CheckFieldAxioms<Mpint64>("field axioms of Mpint64");
+    CheckFieldAxioms<BasicMpint64<EagerReduction>>("field axioms of eager Mpint64");
+    CheckFieldAxioms<Mpint128>("field axioms of Mpint128");
+    CheckFieldAxioms<Goldilocks>("field axioms of Goldilocks");
+    CheckFieldAxioms<GF2_64>("field axioms of GF2_64");
+    CheckFieldAxioms<Ext<Mpint64, 2>>("field axioms of Ext<Mpint64, 2>");
+    CheckFieldAxioms<Ext<Mpint64, 3>>("field axioms of Ext<Mpint64, 3>");
+    CheckFieldAxioms<Ext<Mpint32, 4>>("field axioms of Ext<Mpint32, 4>");
+
+    CheckNttAgainstDft<Goldilocks>("NTT of Goldilocks against the DFT");
+    CheckNttAgainstDft<Ext<Mpint64, 2>>("NTT of Ext<Mpint64, 2> against the DFT");
+    CheckNttAgainstDft<Ext<Mpint32, 2>>("NTT of Ext<Mpint32, 2> against the DFT");
+
+    return TestCheck::GetFailureCount();
+}
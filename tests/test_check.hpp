@@ -0,0 +1,31 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <iostream>
+
+/* Minimal checks for the test executables : failures are reported and counted, and main returns the count */
+class TestCheck
+{
+public:
+    static void Check(const bool condition, const char* name);
+    static int GetFailureCount();
+
+private:
+    static inline int sFailureCount = 0;
+};
+
+inline void TestCheck::Check(const bool condition, const char* name)
+{
+    if (!condition)
+    {
+        std::cout << "FAILED : " << name << std::endl;
+        ++sFailureCount;
+    }
+}
+
+inline int TestCheck::GetFailureCount()
+{
+    return sFailureCount;
+}
+
+#endif
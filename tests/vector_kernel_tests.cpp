@@ -0,0 +1,122 @@
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "test_check.hpp"
+#include "../math/chacha_prg.hpp"
+#include "../math/cpu_features.hpp"
+#include "../math/mpint32.hpp"
+#include "../math/mpint64.hpp"
+#include "../math/packed_codec.hpp"
+#include "../math/vector_kernel.hpp"
+
+/*
+ * Every backend the CPU supports against element-wise field arithmetic, which is the scalar reference.
+ * Lengths cover every remainder modulo the vector widths (4 and 8 words for AVX2, 8 and 16 for AVX-512) and the
+ * 64-value chunks of packing, and Mpint64 operands include incompletely reduced values from sums.
+ */
+template <typename Int> void CheckBackend(const std::string& name)
+{
+    using Word = typename VectorKernel<Int>::Word;
+    const Int minusOne = Int((uint64_t)0) - Int((uint64_t)1);
+
+    std::vector<size_t> lengths;
+    for (size_t length = 0; length <= 70; ++length)
+    {
+        lengths.push_back(length);
+    }
+    lengths.push_back(1021);
+    lengths.push_back(4099);
+
+    bool isArithmeticValid = true;
+    bool isIngestionValid = true;
+    bool isPackingValid = true;
+    for (const size_t length : lengths)
+    {
+        std::vector<Int> op0(length);
+        std::vector<Int> op1(length);
+        Int::FillRandom(op0.data(), length);
+        Int::FillRandom(op1.data(), length);
+        for (size_t i = 0; i < length; i += 3)
+        {
+            op0[i] = op0[i] + minusOne;
+            op1[i] = minusOne + minusOne;
+        }
+        const Int scalar = minusOne + minusOne;
+
+        std::vector<Int> sum(length), difference(length), product(length), scaled(length), axpy(op0);
+        VectorKernel<Int>::Add(sum.data(), op0.data(), op1.data(), length);
+        VectorKernel<Int>::Sub(difference.data(), op0.data(), op1.data(), length);
+        VectorKernel<Int>::Mul(product.data(), op0.data(), op1.data(), length);
+        VectorKernel<Int>::Scale(scaled.data(), op0.data(), scalar, length);
+        VectorKernel<Int>::Axpy(axpy.data(), scalar, op1.data(), length);
+        const Int dot = VectorKernel<Int>::Dot(op0.data(), op1.data(), length);
+
+        Int expectedDot((uint64_t)0);
+        for (size_t i = 0; i < length; ++i)
+        {
+            isArithmeticValid = isArithmeticValid && (sum[i] == op0[i] + op1[i]) &&
+                                (difference[i] == op0[i] - op1[i]) && (product[i] == op0[i] * op1[i]) &&
+                                (scaled[i] == op0[i] * scalar) && (axpy[i] == op0[i] + scalar * op1[i]);
+            expectedDot += op0[i] * op1[i];
+        }
+        isArithmeticValid = isArithmeticValid && (dot == expectedDot);
+
+        // In place, as the kernels allow dst to alias an operand
+        VectorKernel<Int>::Add(op0.data(), op0.data(), op1.data(), length);
+        isArithmeticValid = isArithmeticValid && (op0 == sum);
+
+        std::vector<Word> words(length);
+        ChaChaPrg::GetThreadLocal().Fill(words.data(), length);
+        const bool isCanonical = VectorKernel<Int>::IsCanonical(words.data(), length);
+        bool expectedCanonical = true;
+        std::vector<Int> ingested(length);
+        VectorKernel<Int>::Ingest(ingested.data(), words.data(), length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            expectedCanonical = expectedCanonical && (words[i] < (Word)Int::GetBase());
+            isIngestionValid = isIngestionValid && (ingested[i] == Int(words[i]));
+        }
+        isIngestionValid = isIngestionValid && (isCanonical == expectedCanonical);
+        for (size_t i = 0; i < length; ++i)
+        {
+            words[i] = (Word)Int(words[i]).GetValue();
+        }
+        isIngestionValid = isIngestionValid && VectorKernel<Int>::IsCanonical(words.data(), length);
+
+        std::vector<unsigned char> packed(PackedCodec<Int>::GetPackedBytes(length) + 1u, 0xA5);
+        VectorKernel<Int>::Pack(packed.data(), product.data(), length);
+        std::vector<Int> unpacked(length);
+        VectorKernel<Int>::Unpack(unpacked.data(), packed.data(), length);
+        std::vector<unsigned char> expectedPacked(packed.size(), 0xA5);
+        std::vector<Word> values(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            values[i] = (Word)product[i].GetValue();
+        }
+        BitPacking::Pack<PackedCodec<Int>::BITS>(expectedPacked.data(), values.data(), length);
+        isPackingValid = isPackingValid && (unpacked == product) && (packed == expectedPacked);
+    }
+
+    TestCheck::Check(isArithmeticValid, (name + " arithmetic").c_str());
+    TestCheck::Check(isIngestionValid, (name + " ingestion").c_str());
+    TestCheck::Check(isPackingValid, (name + " packing").c_str());
+}
+
+int main()
+{
+    const SimdLevel levels[] = {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512};
+    for (const SimdLevel level : levels)
+    {
+        if (VectorKernel<Mpint64>::SetSimdLevel(level))
+        {
+            CheckBackend<Mpint64>(std::string("Mpint64 ") + VectorKernel<Mpint64>::GetBackendName());
+        }
+        if (VectorKernel<Mpint32>::SetSimdLevel(level))
+        {
+            CheckBackend<Mpint32>(std::string("Mpint32 ") + VectorKernel<Mpint32>::GetBackendName());
+        }
+    }
+
+    return TestCheck::GetFailureCount();
+}
@@ -1,7 +1,11 @@
 #ifndef INTERACTIVE_PROOF_H
 #define INTERACTIVE_PROOF_H
 
+#include <utility>
+
+#include "..\math\barycentric_evaluator.hpp"
 #include "..\math\polynomial.hpp"
+#include "..\math\polynomial_batch.hpp"
 #include "proof.hpp"
 
 template <typename Int> class InteractiveProof
@@ -10,6 +14,8 @@ public:
     InteractiveProof(const InteractiveProof<Int>& obj);
     InteractiveProof(std::vector<Polynomial<Int>>& polyPs, std::vector<Polynomial<Int>>& polyQs,
                      Polynomial<Int>& polyG);
+    // P_i and Q_i by their values at the nodes 0, ..., nNodes - 1, nNodes values per polynomial
+    InteractiveProof(std::vector<Int> valuesP, std::vector<Int> valuesQ, const size_t nNodes, Polynomial<Int>& polyG);
 
     Int GetQueryAnswer(const Query<Int>& query);
     size_t GetBytes();
@@ -19,16 +25,24 @@ public:
     Int GetRandomFromOracle();
 
 private:
-    std::vector<Polynomial<Int>> mPolyPs;
-    std::vector<Polynomial<Int>> mPolyQs;
+    PolynomialBatch<Int> mPolyPs;
+    PolynomialBatch<Int> mPolyQs;
+    std::vector<Int> mValuesP;
+    std::vector<Int> mValuesQ;
+    size_t mNodeCount; // 0 when P_i and Q_i are given by coefficients
     Proof<Int> mProof;
     bool mIsFinalRound;
+
+    std::vector<Int> EvaluateValues(const std::vector<Int>& values, Int x) const;
 };
 
 template <typename Int> InteractiveProof<Int>::InteractiveProof(const InteractiveProof<Int>& obj)
 {
     mPolyPs = obj.mPolyPs;
     mPolyQs = obj.mPolyQs;
+    mValuesP = obj.mValuesP;
+    mValuesQ = obj.mValuesQ;
+    mNodeCount = obj.mNodeCount;
     mProof = obj.mProof;
     mIsFinalRound = obj.mIsFinalRound;
 }
@@ -37,18 +51,23 @@ template <typename Int>
 InteractiveProof<Int>::InteractiveProof(std::vector<Polynomial<Int>>& pPolys, std::vector<Polynomial<Int>>& qPolys,
                                         Polynomial<Int>& gPoly)
 {
-    mPolyPs.reserve(pPolys.size());
-    for (size_t i = 0; i < pPolys.size(); ++i)
-    {
-        mPolyPs.emplace_back(pPolys[i]);
-    }
+    mPolyPs = PolynomialBatch<Int>(pPolys);
+    mPolyQs = PolynomialBatch<Int>(qPolys);
 
-    mPolyQs.reserve(qPolys.size());
-    for (size_t i = 0; i < qPolys.size(); ++i)
-    {
-        mPolyQs.emplace_back(qPolys[i]);
-    }
+    mNodeCount = 0u;
+    mProof = Proof(gPoly);
+    mIsFinalRound = false;
+}
 
+template <typename Int>
+InteractiveProof<Int>::InteractiveProof(std::vector<Int> valuesP, std::vector<Int> valuesQ, const size_t nNodes,
+                                        Polynomial<Int>& gPoly)
+{
+    assert(nNodes > 0u && valuesP.size() % nNodes == 0u && valuesQ.size() % nNodes == 0u);
+
+    mValuesP = std::move(valuesP);
+    mValuesQ = std::move(valuesQ);
+    mNodeCount = nNodes;
     mProof = Proof(gPoly);
     mIsFinalRound = false;
 }
@@ -70,24 +89,22 @@ template <typename Int> std::vector<Proof<Int>> InteractiveProof<Int>::GetShares
 
 template <typename Int> std::vector<Int> InteractiveProof<Int>::EvaluatePolyPs(Int x)
 {
-    std::vector<Int> results;
-    results.reserve(mPolyPs.size());
-    for (size_t i = 0; i < mPolyPs.size(); ++i)
+    if (mNodeCount > 0u)
     {
-        results.emplace_back(mPolyPs[i].Evaluate(x));
+        return EvaluateValues(mValuesP, x);
     }
-    return results;
+
+    return mPolyPs.Evaluate(x);
 }
 
 template <typename Int> std::vector<Int> InteractiveProof<Int>::EvaluatePolyQs(Int x)
 {
-    std::vector<Int> results;
-    results.reserve(mPolyQs.size());
-    for (size_t i = 0; i < mPolyQs.size(); ++i)
+    if (mNodeCount > 0u)
     {
-        results.emplace_back(mPolyQs[i].Evaluate(x));
+        return EvaluateValues(mValuesQ, x);
     }
-    return results;
+
+    return mPolyQs.Evaluate(x);
 }
 
 template <typename Int> Int InteractiveProof<Int>::GetRandomFromOracle()
@@ -95,4 +112,20 @@ template <typename Int> Int InteractiveProof<Int>::GetRandomFromOracle()
     return mProof.GetRandomFromOracle();
 }
 
+// One set of Lagrange weights at x, then a dot product per polynomial
+template <typename Int>
+std::vector<Int> InteractiveProof<Int>::EvaluateValues(const std::vector<Int>& values, Int x) const
+{
+    std::vector<Int> weights(mNodeCount);
+    BarycentricEvaluator<Int>::CopyWeights(weights.data(), x, mNodeCount);
+
+    std::vector<Int> results;
+    results.reserve(values.size() / mNodeCount);
+    for (size_t i = 0; i < values.size(); i += mNodeCount)
+    {
+        results.emplace_back(VectorKernel<Int>::Dot(weights.data(), values.data() + i, mNodeCount));
+    }
+    return results;
+}
+
 #endif
@@ -4,8 +4,11 @@
 #include <cassert>
 #include <vector>
 
+#include "../math/operation_counter.hpp"
+#include "../math/packed_codec.hpp"
 #include "../math/polynomial.hpp"
 #include "../math/sha512.hpp"
+#include "../math/vector_kernel.hpp"
 #include "query.hpp"
 
 template<typename Int> class Proof
@@ -20,7 +23,9 @@ public:
     ~Proof();
 
     Int GetQueryAnswer(const Query<Int>& query) const;
-    size_t GetBytes() const;
+    template <size_t K> Ext<Int, K> GetQueryAnswer(const Query<Ext<Int, K>>& query) const;
+    size_t GetBytes() const;           // Packed size of the proof part, see PackedCodec
+    void Pack(unsigned char* dst) const; // Writes GetBytes() bytes
     size_t GetLength() const;
     std::vector<Proof<Int>> GetShares(size_t nShares);
     std::vector<Int> GetRandoms(size_t nRandoms);
@@ -109,18 +114,32 @@ template <typename Int> Int Proof<Int>::GetQueryAnswer(const Query<Int>& query)
 {
     assert(mLength == query.mLength);
 
-    Int result((uint64_t)0);
+    return VectorKernel<Int>::Dot(mValues, query.mValues, mLength);
+}
+
+// Base field proof against extension field queries : K base field multiplications per entry
+template <typename Int>
+template <size_t K>
+Ext<Int, K> Proof<Int>::GetQueryAnswer(const Query<Ext<Int, K>>& query) const
+{
+    assert(mLength == query.mLength);
+
+    Accumulator<Ext<Int, K>> answer;
     for (size_t i = 0; i < mLength; ++i)
     {
-        result += mValues[i] * query.mValues[i];
+        answer.MultiplyAdd(query.mValues[i], mValues[i]);
     }
-
-    return result;
+    return answer.Get();
 }
 
 template <typename Int> size_t Proof<Int>::GetBytes() const
 {
-    return mProofLength * sizeof(Int);
+    return PackedCodec<Int>::GetPackedBytes(mProofLength);
+}
+
+template <typename Int> void Proof<Int>::Pack(unsigned char* dst) const
+{
+    PackedCodec<Int>::Pack(dst, mValues + (mLength - mProofLength), mProofLength);
 }
 
 template <typename Int> size_t Proof<Int>::GetLength() const
@@ -140,11 +159,8 @@ template <typename Int> std::vector<Proof<Int>> Proof<Int>::GetShares(size_t nSh
     for (size_t i = 0; i < nShares - 1; ++i)
     {
         Int* randomValues = new Int[mLength];
-        for (size_t j = 0; j < mLength; ++j)
-        {
-            randomValues[j] = Int::GenerateRandom();
-            valuesCopy[j] -= randomValues[j];
-        }
+        Int::FillRandom(randomValues, mLength);
+        VectorKernel<Int>::Sub(valuesCopy, valuesCopy, randomValues, mLength);
 
         shares.emplace_back(randomValues, mLength, mProofLength);
 
@@ -174,9 +190,12 @@ template <typename Int> std::vector<Int> Proof<Int>::GetRandoms(size_t nRandoms)
 
 template <typename Int> Int Proof<Int>::GetRandomFromOracle()
 {
+    Int::Canonicalize(mValues + (mLength - mProofLength), mProofLength);
+
     SHA512_CTX ctx;
     unsigned char digest[SHA512_DIGEST_LENGTH];
     SHA512_Init(&ctx);
+    OperationCounter::Count(OperationCounter::Operation::HashedByte, mProofLength * sizeof(Int));
     SHA512_Update(&ctx, mValues + (mLength - mProofLength), mProofLength * sizeof(Int));
     SHA512_Final(digest, &ctx);
     return Int(digest);
@@ -184,6 +203,8 @@ template <typename Int> Int Proof<Int>::GetRandomFromOracle()
 
 template <typename Int> Int Proof<Int>::GetRandomFromOracle(unsigned char* secretKey, const size_t keyLength)
 {
+    Int::Canonicalize(mValues + (mLength - mProofLength), mProofLength);
+
     SHA512_CTX ctx;
     unsigned char digest[SHA512_DIGEST_LENGTH];
     SHA512_Init(&ctx);
@@ -192,6 +213,8 @@ template <typename Int> Int Proof<Int>::GetRandomFromOracle(unsigned char* secre
     std::memcpy(values, secretKey, keyLength * sizeof(unsigned char));
     std::memcpy(values + keyLength, mValues + (mLength - mProofLength), mProofLength * sizeof(Int));
 
+    OperationCounter::Count(OperationCounter::Operation::HashedByte,
+                            keyLength * sizeof(unsigned char) + mProofLength * sizeof(Int));
     SHA512_Update(&ctx, values, keyLength * sizeof(unsigned char) + mProofLength * sizeof(Int));
     SHA512_Final(digest, &ctx);
 
@@ -8,7 +8,7 @@ template <typename Int> class Proof;
 template <typename Int> class Query
 {
 public:
-    friend Int Proof<Int>::GetQueryAnswer(const Query<Int>&) const;
+    template <typename> friend class Proof;
 
     Query();
     Query(Int* values, size_t length);